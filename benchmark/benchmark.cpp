@@ -0,0 +1,659 @@
+/**
+ * @file benchmark.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Micro-benchmarks of the rules core (built with "make bench", not part of the game)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <chrono>
+# include <cmath>
+# include <cstdint>
+# include <filesystem>
+# include <fstream>
+# include <functional>
+# include <iomanip>
+# include <iostream>
+# include <iterator>
+# include <memory>
+# include <stdexcept>
+# include <string>
+# include <vector>
+using namespace std;
+namespace fs = std::filesystem;
+
+// #### Internal inclusions: ####
+# include "../header/game.hpp"
+# include "../header/movecache.hpp"
+# include "../header/perfcounters.hpp"
+
+
+namespace
+{
+  /**
+   * @brief The positions of every benchmark (opening, middlegames with castling rights,
+   * pins and en passant, promotions, endgame)
+   *
+   */
+  const char* POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+    "rnbqkb1r/pp1p1ppp/5n2/2pPp3/8/8/PPP1PPPP/RNBQKBNR w KQkq c6 0 4",
+    "8/8/4k3/3p4/3P4/4K3/5B2/8 b - - 0 1"
+  };
+
+  const char* TYPE_NAMES[] = {"pawn", "knight", "bishop", "rook", "queen", "king"};
+  const char* EVENT_KEYS[PerfCounters::EVENTS] = {"cycles", "instructions", "l1_misses", "llc_misses", "branch_misses"}; //< In the JSON
+
+  volatile uint64_t sink = 0; //< Every result is folded in it, so that the compiler cannot drop the measured calls
+
+
+  /**
+   * @brief A benchmark: a round calls the measured function once on each of its inputs
+   *
+   */
+  struct Benchmark
+  {
+    string name; //< e.g. "read/rook"
+    function<long()> round; //< Run a round and return its number of operations
+  };
+
+  /**
+   * @brief The timings of a benchmark, in nanoseconds per operation
+   *
+   */
+  struct Result
+  {
+    string name;
+    long operations = 0; //< The operations of a round
+    int samples = 0;
+    double mean = 0, stddev = 0, min = 0, max = 0;
+    bool counted[PerfCounters::EVENTS] = {}; //< If each hardware counter was read
+    double counters[PerfCounters::EVENTS] = {}; //< The hardware events per operation
+  };
+
+
+  /**
+   * @brief Build a game for each position of POSITIONS
+   *
+   * @return vector<unique_ptr<Game>>
+   */
+  vector<unique_ptr<Game>> positions()
+  {
+    vector<unique_ptr<Game>> output;
+    for (const char* fen : POSITIONS)
+    {
+      output.push_back(make_unique<Game>());
+      output.back()->setFen(fen);
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief To get the pieces of the player that has to play
+   *
+   * @param game The game
+   * @return vector<Piece*>
+   */
+  vector<Piece*> movablePieces(const Game& game)
+  {
+    vector<Piece*> output;
+    Bitboard pieces = game.occupied(game.turn());
+    while (pieces)
+    {
+      int square = popLsb(pieces);
+      output.push_back(game.at(squareX(square), squareY(square)));
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief Build the benchmarks (their inputs are computed once, outside the measures)
+   *
+   * @param games The positions, shared by the benchmarks
+   * @return vector<Benchmark>
+   */
+  vector<Benchmark> benchmarks(vector<unique_ptr<Game>>& games)
+  {
+    vector<Benchmark> output;
+
+    // Piece::read, once for each piece of the player to move
+    for (int type = PAWN; type <= KING; ++ type)
+    {
+      auto pieces = make_shared<vector<Piece*>>();
+      for (unique_ptr<Game>& game : games)
+      {
+        for (Piece* piece : movablePieces(*game))
+        {
+          if (piece->type() == type)
+          {
+            pieces->push_back(piece);
+          }
+        }
+      }
+      output.push_back({string("read/") + TYPE_NAMES[type], [pieces]
+      {
+        for (Piece* piece : *pieces)
+        {
+          sink += piece->read().size();
+        }
+        return long(pieces->size());
+      }});
+    }
+
+    // Game::move of every legal move, taken back with Game::unmakeMove
+    struct Play
+    {
+      Game* game;
+      Piece* piece;
+      int x, y, promotion;
+    };
+    auto plays = make_shared<vector<Play>>();
+    for (unique_ptr<Game>& game : games)
+    {
+      MoveList moves;
+      game->legalMoves(moves);
+      for (const Move move : moves)
+      {
+        plays->push_back({game.get(), game->at(squareX(move.from()), squareY(move.from())), move.x(), move.y(), move.promotion()});
+      }
+    }
+    output.push_back({"move", [plays]
+    {
+      for (const Play& play : *plays)
+      {
+        sink += play.game->move(play.piece, play.x, play.y, play.promotion);
+        play.game->unmakeMove();
+      }
+      return long(plays->size());
+    }});
+
+    // The move generation, without the MoveCache
+    output.push_back({"legalMoves", [&games]
+    {
+      MoveList moves;
+      for (unique_ptr<Game>& game : games)
+      {
+        game->legalMoves(moves);
+        sink += moves.size();
+      }
+      return long(games.size());
+    }});
+
+    output.push_back({"countLegalMoves", [&games]
+    {
+      for (unique_ptr<Game>& game : games)
+      {
+        sink += game->countLegalMoves();
+      }
+      return long(games.size());
+    }});
+
+    // MoveCache::find of the positions, in a cache that holds them (hit) and in an empty one (miss)
+    auto keys = make_shared<vector<Position>>();
+    auto full = make_shared<MoveCache>(MoveCache::ENTRIES), empty = make_shared<MoveCache>(MoveCache::ENTRIES);
+    for (unique_ptr<Game>& game : games)
+    {
+      MoveList moves;
+      game->legalMoves(moves);
+      keys->push_back(game->position());
+      full->store(keys->back(), moves);
+    }
+    auto lookups = [keys](shared_ptr<MoveCache> cache)
+    {
+      return [keys, cache]
+      {
+        MoveList moves;
+        for (const Position& key : *keys)
+        {
+          sink += cache->find(key, moves) + moves.size();
+        }
+        return long(keys->size());
+      };
+    };
+    output.push_back({"cache/hit", lookups(full)});
+    output.push_back({"cache/miss", lookups(empty)});
+
+    // Game::isDiscoveryCheck, for each piece of the player to move
+    output.push_back({"isDiscoveryCheck", [&games]
+    {
+      long operations = 0;
+      for (unique_ptr<Game>& game : games)
+      {
+        Bitboard pieces = game->occupied(game->turn()) & ~game->pieces(game->turn(), KING);
+        operations += popCount(pieces);
+        while (pieces)
+        {
+          int square = popLsb(pieces);
+          sink += game->isDiscoveryCheck(squareX(square), squareY(square), game->turn()) != nullptr;
+        }
+      }
+      return operations;
+    }});
+
+    output.push_back({"hash", [&games]
+    {
+      for (unique_ptr<Game>& game : games)
+      {
+        sink ^= game->hash();
+      }
+      return long(games.size());
+    }});
+
+    output.push_back({"isMate", [&games]
+    {
+      for (unique_ptr<Game>& game : games)
+      {
+        sink += game->isMate();
+      }
+      return long(games.size());
+    }});
+
+    // Game::save then Game(path), in a file that is removed at the end
+    output.push_back({"save+load", [&games]
+    {
+      static string name = ".benchmark";
+      static string path = "memory/saved_games/" + name;
+      fs::create_directories("memory/saved_games");
+      for (unique_ptr<Game>& game : games)
+      {
+        game->setName(name);
+        game->save();
+        Game loaded(path);
+        sink ^= loaded.hash();
+      }
+      fs::remove(path);
+      return long(games.size());
+    }});
+
+    return output;
+  }
+
+
+  /**
+   * @brief Time a benchmark
+   * @note The number of rounds of a sample is calibrated first, so that a sample lasts about sampleTime.
+   * The hardware counters (if any) are read around all the samples
+   *
+   * @param benchmark The benchmark
+   * @param samples The number of samples
+   * @param sampleTime The duration of a sample (in seconds)
+   * @param counters The hardware counters (nullptr: none)
+   * @return Result
+   */
+  Result measure(const Benchmark& benchmark, const int samples, const double sampleTime, PerfCounters* counters)
+  {
+    using Clock = chrono::steady_clock;
+    Result output;
+    output.name = benchmark.name;
+    output.samples = samples;
+    output.operations = benchmark.round(); //< Also warms the caches up
+
+    long rounds = 1;
+    while (true)
+    {
+      auto start = Clock::now();
+      for (long round = 0; round < rounds; ++ round)
+      {
+        benchmark.round();
+      }
+      double seconds = chrono::duration<double>(Clock::now() - start).count();
+      if (seconds >= sampleTime / 10)
+      {
+        rounds = max(1L, long(rounds * sampleTime / seconds));
+        break;
+      }
+      rounds <<= 1;
+    }
+
+    vector<double> timings;
+    if (counters)
+    {
+      counters->start();
+    }
+    for (int sample = 0; sample < samples; ++ sample)
+    {
+      auto start = Clock::now();
+      for (long round = 0; round < rounds; ++ round)
+      {
+        benchmark.round();
+      }
+      double nanoseconds = chrono::duration<double, nano>(Clock::now() - start).count();
+      timings.push_back(nanoseconds / (rounds * max(1L, output.operations)));
+    }
+    if (counters)
+    {
+      counters->stop();
+      for (int event = 0; event < PerfCounters::EVENTS; ++ event)
+      {
+        output.counted[event] = counters->available(PerfCounters::Event(event));
+        output.counters[event] = double(counters->read(PerfCounters::Event(event))) / (double(samples) * rounds * max(1L, output.operations));
+      }
+    }
+
+    output.min = output.max = timings[0];
+    for (double timing : timings)
+    {
+      output.mean += timing / samples;
+      output.min = min(output.min, timing);
+      output.max = max(output.max, timing);
+    }
+    for (double timing : timings)
+    {
+      output.stddev += (timing - output.mean) * (timing - output.mean);
+    }
+    output.stddev = samples > 1 ? sqrt(output.stddev / (samples - 1)) : 0;
+    return output;
+  }
+
+
+  /**
+   * @brief Write results as JSON (one benchmark per line, see readResults)
+   *
+   * @param stream The output
+   * @param results The results
+   */
+  void writeResults(ostream& stream, const vector<Result>& results)
+  {
+    stream << "{\n  \"unit\": \"ns/op\",\n  \"positions\": " << size(POSITIONS) << ",\n  \"benchmarks\": [\n";
+    for (size_t index = 0; index < results.size(); ++ index)
+    {
+      const Result& result = results[index];
+      stream << "    {\"name\": \"" << result.name << "\", \"operations\": " << result.operations
+             << ", \"samples\": " << result.samples << fixed << setprecision(3)
+             << ", \"mean\": " << result.mean << ", \"stddev\": " << result.stddev
+             << ", \"min\": " << result.min << ", \"max\": " << result.max;
+      for (int event = 0; event < PerfCounters::EVENTS; ++ event)
+      {
+        if (result.counted[event])
+        {
+          stream << ", \"" << EVENT_KEYS[event] << "\": " << result.counters[event];
+        }
+      }
+      if (result.counted[PerfCounters::CYCLES] and result.counted[PerfCounters::INSTRUCTIONS])
+      {
+        stream << ", \"ipc\": " << result.counters[PerfCounters::INSTRUCTIONS] / max(result.counters[PerfCounters::CYCLES], 1e-9);
+      }
+      stream << "}" << (index + 1 < results.size() ? ",\n" : "\n");
+    }
+    stream << "  ]\n}" << endl;
+  }
+
+
+  /**
+   * @brief To get the number that follows a key in a line of JSON
+   *
+   * @param line The line
+   * @param key The key (without quotes)
+   * @return double
+   */
+  double number(const string& line, const string& key)
+  {
+    size_t position = line.find("\"" + key + "\": ");
+    if (position == string::npos)
+    {
+      throw runtime_error("missing \"" + key + "\" in: " + line);
+    }
+    return stod(line.substr(position + key.size() + 4));
+  }
+
+
+  /**
+   * @brief Read the results written by writeResults
+   * @throw std::runtime_error If the file cannot be read
+   *
+   * @param path The path of the JSON file
+   * @return vector<Result>
+   */
+  vector<Result> readResults(const string& path)
+  {
+    ifstream file(path);
+    if (not file)
+    {
+      throw runtime_error("cannot read " + path);
+    }
+    vector<Result> output;
+    string line;
+    while (getline(file, line))
+    {
+      size_t position = line.find("\"name\": \"");
+      if (position == string::npos)
+      {
+        continue;
+      }
+      position += 9;
+      Result result;
+      result.name = line.substr(position, line.find('"', position) - position);
+      result.operations = number(line, "operations");
+      result.samples = number(line, "samples");
+      result.mean = number(line, "mean");
+      result.stddev = number(line, "stddev");
+      result.min = number(line, "min");
+      result.max = number(line, "max");
+      output.push_back(result);
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief Print a table of results
+   *
+   * @param results The results
+   */
+  void printResults(const vector<Result>& results)
+  {
+    cout << left << setw(20) << "benchmark" << right << setw(12) << "ns/op" << setw(12) << "stddev"
+         << setw(9) << "" << setw(12) << "min" << setw(10) << "ops" << '\n';
+    for (const Result& result : results)
+    {
+      cout << left << setw(20) << result.name << right << fixed << setprecision(2)
+           << setw(12) << result.mean << setw(12) << result.stddev
+           << setw(8) << setprecision(1) << 100 * result.stddev / max(result.mean, 1e-9) << '%'
+           << setw(12) << setprecision(2) << result.min << setw(10) << result.operations << '\n';
+    }
+    cout << flush;
+  }
+
+
+  /**
+   * @brief Print a table of the hardware events per operation ("-" for the missing counters)
+   *
+   * @param results The results
+   */
+  void printCounters(const vector<Result>& results)
+  {
+    cout << '\n' << left << setw(20) << "benchmark" << right << setw(12) << "cycles/op" << setw(12) << "instr/op"
+         << setw(8) << "IPC" << setw(12) << "L1 miss/op" << setw(12) << "LLC miss/op" << setw(16) << "branch miss/op" << '\n';
+    for (const Result& result : results)
+    {
+      auto column = [&result](const PerfCounters::Event event, const int width)
+      {
+        if (result.counted[event])
+        {
+          cout << setw(width) << result.counters[event];
+        }
+        else
+        {
+          cout << setw(width) << "-";
+        }
+      };
+      cout << left << setw(20) << result.name << right << fixed << setprecision(2);
+      column(PerfCounters::CYCLES, 12);
+      column(PerfCounters::INSTRUCTIONS, 12);
+      if (result.counted[PerfCounters::CYCLES] and result.counted[PerfCounters::INSTRUCTIONS])
+      {
+        cout << setw(8) << result.counters[PerfCounters::INSTRUCTIONS] / max(result.counters[PerfCounters::CYCLES], 1e-9);
+      }
+      else
+      {
+        cout << setw(8) << "-";
+      }
+      cout << setprecision(4);
+      column(PerfCounters::L1_MISSES, 12);
+      column(PerfCounters::LLC_MISSES, 12);
+      column(PerfCounters::BRANCH_MISSES, 16);
+      cout << '\n';
+    }
+    cout << flush;
+  }
+
+
+  /**
+   * @brief Print the difference between two runs
+   * @note A change is significant when it is larger than twice the standard error of the difference
+   * and than 1% (the machine is never perfectly quiet)
+   *
+   * @param before The results of the reference run
+   * @param after The results of the new run
+   */
+  void compareResults(const vector<Result>& before, const vector<Result>& after)
+  {
+    cout << left << setw(20) << "benchmark" << right << setw(12) << "before" << setw(12) << "after"
+         << setw(10) << "change" << "  verdict\n";
+    for (const Result& old : before)
+    {
+      for (const Result& result : after)
+      {
+        if (result.name != old.name)
+        {
+          continue;
+        }
+        double change = result.mean - old.mean;
+        double error = sqrt(old.stddev * old.stddev / max(old.samples, 1) + result.stddev * result.stddev / max(result.samples, 1));
+        double percent = 100 * change / max(old.mean, 1e-9);
+        string verdict = "same";
+        if (abs(change) > 2 * error and abs(percent) > 1)
+        {
+          verdict = change < 0 ? "faster" : "slower";
+        }
+        cout << left << setw(20) << result.name << right << fixed << setprecision(2)
+             << setw(12) << old.mean << setw(12) << result.mean
+             << setw(9) << showpos << setprecision(1) << percent << noshowpos << '%' << "  " << verdict << '\n';
+      }
+    }
+    cout << flush;
+  }
+}
+
+
+/**
+ * @brief Run the benchmarks: "chess_bench [--filter TEXT] [--samples N] [--time MS] [--json FILE] [--counters]"
+ * or compare two runs: "chess_bench --compare BEFORE.json AFTER.json"
+ *
+ * @param argc The number of arguments
+ * @param argv The arguments
+ * @return int The exit code
+ */
+int main(int argc, char** argv)
+{
+  // Options
+  string filter, json, before, after;
+  int samples = 10, milliseconds = 50;
+  bool valid = true, counted = false;
+  try
+  {
+    for (int index = 1; index < argc and valid; ++ index)
+    {
+      string argument = argv[index];
+      if (argument == "--filter" and index + 1 < argc)
+      {
+        filter = argv[++ index];
+      }
+      else if (argument == "--samples" and index + 1 < argc)
+      {
+        samples = stoi(argv[++ index]);
+      }
+      else if (argument == "--time" and index + 1 < argc)
+      {
+        milliseconds = stoi(argv[++ index]);
+      }
+      else if (argument == "--json" and index + 1 < argc)
+      {
+        json = argv[++ index];
+      }
+      else if (argument == "--counters")
+      {
+        counted = true;
+      }
+      else if (argument == "--compare" and index + 2 < argc)
+      {
+        before = argv[++ index];
+        after = argv[++ index];
+      }
+      else
+      {
+        valid = false;
+      }
+    }
+  }
+  catch (const logic_error&)
+  {
+    valid = false;
+  }
+  if (not valid or samples < 1 or milliseconds < 1)
+  {
+    cerr << "usage: chess_bench [--filter TEXT] [--samples N] [--time MS] [--json FILE] [--counters]\n"
+         << "       chess_bench --compare BEFORE.json AFTER.json" << endl;
+    return 1;
+  }
+
+  try
+  {
+    if (before.size())
+    {
+      compareResults(readResults(before), readResults(after));
+      return 0;
+    }
+    unique_ptr<PerfCounters> counters;
+    if (counted)
+    {
+      counters = make_unique<PerfCounters>();
+      if (not counters->available())
+      {
+        cerr << "hardware counters unavailable (" << counters->error() << "), timing only" << endl;
+        counters.reset();
+      }
+    }
+    vector<unique_ptr<Game>> games = positions();
+    vector<Result> results;
+    for (const Benchmark& benchmark : benchmarks(games))
+    {
+      if (benchmark.name.find(filter) != string::npos)
+      {
+        results.push_back(measure(benchmark, samples, milliseconds / 1000., counters.get()));
+      }
+    }
+    printResults(results);
+    if (counters)
+    {
+      printCounters(results);
+    }
+    if (json.size())
+    {
+      ofstream file(json);
+      if (not file)
+      {
+        throw runtime_error("cannot write " + json);
+      }
+      writeResults(file, results);
+    }
+  }
+  catch (const exception& error)
+  {
+    cerr << error.what() << endl;
+    return 1;
+  }
+  return 0;
+}
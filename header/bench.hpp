@@ -0,0 +1,26 @@
+/**
+ * @file bench.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the bench command (fixed workload of the rules)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+/**
+ * @brief Run the command "chess bench", without ncurses
+ * @note Play a fixed set of games from a fixed set of positions, through the calls of run
+ * (Game::at, Piece::read, Game::move, Game::isMate), and print the number of moves read
+ * (the signature: it only changes if the rules change) and the throughput
+ *
+ * @param argc The number of arguments (after "bench")
+ * @param argv The arguments (after "bench")
+ * @return int The exit code
+ */
+int benchCommand(const int argc, char** argv);
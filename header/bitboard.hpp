@@ -0,0 +1,277 @@
+/**
+ * @file bitboard.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the bitboard helpers
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <array>
+# include <cstdint>
+using namespace std;
+
+
+/**
+ * @brief A set of squares, bit n is the square n = (y << 3) | x
+ * @note The square 0 is the top left corner of the board (a8), the square 63 is h1
+ *
+ */
+typedef uint64_t Bitboard;
+
+
+// #### Squares: ####
+
+/**
+ * @brief To get the index of the square (x, y)
+ *
+ * @param x The x pos (col) of the square
+ * @param y The y pos (row) of the square
+ * @return int The index of the square (from 0 to 63)
+ */
+constexpr int square(const int x, const int y) noexcept
+{
+  return (y << 3) | x;
+}
+
+/**
+ * @brief To get the x pos (col) of a square
+ *
+ * @param square The index of the square
+ * @return int
+ */
+constexpr int squareX(const int square) noexcept
+{
+  return square & 7;
+}
+
+/**
+ * @brief To get the y pos (row) of a square
+ *
+ * @param square The index of the square
+ * @return int
+ */
+constexpr int squareY(const int square) noexcept
+{
+  return square >> 3;
+}
+
+/**
+ * @brief To get the singleton set of a square
+ *
+ * @param square The index of the square
+ * @return Bitboard
+ */
+constexpr Bitboard bit(const int square) noexcept
+{
+  return Bitboard(1) << square;
+}
+
+// #### Set operations: ####
+
+/**
+ * @brief To get the number of squares in a set
+ *
+ * @param set The set of squares
+ * @return int
+ */
+inline int popCount(const Bitboard set) noexcept
+{
+# ifdef __POPCNT__
+  return __builtin_popcountll(set);
+# else
+  // Without the popcnt instruction the builtin is a library call, this is faster (SWAR)
+  Bitboard count = set - ((set >> 1) & 0x5555555555555555ULL);
+  count = (count & 0x3333333333333333ULL) + ((count >> 2) & 0x3333333333333333ULL);
+  count = (count + (count >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+  return (count * 0x0101010101010101ULL) >> 56;
+# endif
+}
+
+/**
+ * @brief To get the lowest square of a non-empty set
+ *
+ * @param set The set of squares (must not be empty)
+ * @return int
+ */
+inline int lsb(const Bitboard set) noexcept
+{
+  return __builtin_ctzll(set);
+}
+
+/**
+ * @brief Remove the lowest square of a non-empty set and return it
+ *
+ * @param set The set of squares (must not be empty)
+ * @return int
+ */
+inline int popLsb(Bitboard& set) noexcept
+{
+  int output = lsb(set);
+  set &= set - 1;
+  return output;
+}
+
+// #### Attacks: ####
+
+/**
+ * @brief The jumps (x, y) of the leapers
+ *
+ */
+constexpr int KNIGHT_OFFSETS[8][2] = {{2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}};
+constexpr int KING_OFFSETS[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1}};
+constexpr int PAWN_OFFSETS[2][2][2] = {{{1, -1}, {-1, -1}}, {{1, 1}, {-1, 1}}}; //< Captures only, White goes up
+
+/**
+ * @brief Build the attack table of a leaper (a piece that jumps to fixed offsets)
+ *
+ * @param offsets The jumps (x, y) of the leaper
+ * @return array<Bitboard, 64> The attacked squares, for each square
+ */
+template <size_t N>
+constexpr array<Bitboard, 64> leaperTable(const int (&offsets)[N][2]) noexcept
+{
+  array<Bitboard, 64> output = {};
+  for (int from = 0; from < 64; ++ from)
+  {
+    for (const int (&offset)[2] : offsets)
+    {
+      int x = squareX(from) + offset[0], y = squareY(from) + offset[1];
+      if (0 <= x and x < 8 and 0 <= y and y < 8)
+      {
+        output[from] |= bit(square(x, y));
+      }
+    }
+  }
+  return output;
+}
+
+inline constexpr array<Bitboard, 64> KNIGHT_ATTACKS = leaperTable(KNIGHT_OFFSETS);
+inline constexpr array<Bitboard, 64> KING_ATTACKS = leaperTable(KING_OFFSETS);
+inline constexpr array<Bitboard, 64> PAWN_ATTACKS[2] = {leaperTable(PAWN_OFFSETS[0]), leaperTable(PAWN_OFFSETS[1])};
+
+/**
+ * @brief To get the squares attacked by a knight
+ *
+ * @param square The square of the knight
+ * @return Bitboard
+ */
+inline Bitboard knightAttacks(const int square) noexcept
+{
+  return KNIGHT_ATTACKS[square];
+}
+
+/**
+ * @brief To get the squares attacked by a king
+ *
+ * @param square The square of the king
+ * @return Bitboard
+ */
+inline Bitboard kingAttacks(const int square) noexcept
+{
+  return KING_ATTACKS[square];
+}
+
+/**
+ * @brief To get the squares attacked by a pawn (diagonal captures only)
+ *
+ * @param player The owner of the pawn (0: White, 1: Black)
+ * @param square The square of the pawn
+ * @return Bitboard
+ */
+inline Bitboard pawnAttacks(const bool player, const int square) noexcept
+{
+  return PAWN_ATTACKS[player][square];
+}
+
+/**
+ * @brief A magic bitboard entry: maps the blockers of a square to its precomputed attacks
+ * @note The tables are filled once at startup (see source/bitboard.cpp)
+ *
+ */
+struct Magic
+{
+  Bitboard mask = 0; //< The squares whose occupancy changes the attacks (edges excluded)
+  Bitboard magic = 0; //< The multiplier that hashes the blockers without collision
+  Bitboard* attacks = nullptr; //< The slice of the attack table of the square
+  int shift = 0; //< 64 minus the number of bits in mask
+
+  /**
+   * @brief To get the index of the attacks for an occupancy
+   *
+   * @param occupancy The occupied squares
+   * @return unsigned
+   */
+  unsigned index(const Bitboard occupancy) const noexcept
+  {
+    return ((occupancy & mask) * magic) >> shift;
+  }
+};
+
+extern Magic ROOK_MAGICS[64];
+extern Magic BISHOP_MAGICS[64];
+
+/**
+ * @brief To get the squares attacked by a rook, rays stop on the first occupied square
+ *
+ * @param square The square of the rook
+ * @param occupancy The occupied squares
+ * @return Bitboard
+ */
+inline Bitboard rookAttacks(const int square, const Bitboard occupancy) noexcept
+{
+  const Magic& entry = ROOK_MAGICS[square];
+  return entry.attacks[entry.index(occupancy)];
+}
+
+/**
+ * @brief To get the squares attacked by a bishop, rays stop on the first occupied square
+ *
+ * @param square The square of the bishop
+ * @param occupancy The occupied squares
+ * @return Bitboard
+ */
+inline Bitboard bishopAttacks(const int square, const Bitboard occupancy) noexcept
+{
+  const Magic& entry = BISHOP_MAGICS[square];
+  return entry.attacks[entry.index(occupancy)];
+}
+
+/**
+ * @brief To get the squares attacked by a queen, rays stop on the first occupied square
+ *
+ * @param square The square of the queen
+ * @param occupancy The occupied squares
+ * @return Bitboard
+ */
+inline Bitboard queenAttacks(const int square, const Bitboard occupancy) noexcept
+{
+  return rookAttacks(square, occupancy) | bishopAttacks(square, occupancy);
+}
+
+// #### Lines: ####
+
+/**
+ * @brief To get the squares strictly between two aligned squares
+ *
+ * @param a The first square
+ * @param b The second square
+ * @return Bitboard The empty set if a and b are not on the same row, col or diagonal
+ */
+Bitboard between(const int a, const int b) noexcept;
+
+/**
+ * @brief To get the whole line (row, col or diagonal) that goes through two squares
+ *
+ * @param a The first square
+ * @param b The second square
+ * @return Bitboard The empty set if a and b are not on the same row, col or diagonal
+ */
+Bitboard line(const int a, const int b) noexcept;
@@ -0,0 +1,26 @@
+/**
+ * @file check.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the check command (self checks of the game state, run by make check)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+/**
+ * @brief Run the command "chess check", without ncurses
+ * @note Play random games from a fixed set of positions and check that unmakeMove restores the exact Position,
+ * that play agrees with makeMove, that the incremental key equals the key computed from scratch, that the draws by
+ * repetition and by the 50 moves rule are found, and that a saved game loads back to the same Position
+ *
+ * @param argc The number of arguments (after "check")
+ * @param argv The arguments (after "check")
+ * @return int The exit code (1 if a check failed)
+ */
+int checkCommand(const int argc, char** argv);
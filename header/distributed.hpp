@@ -0,0 +1,52 @@
+/**
+ * @file distributed.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the distributed perft (coordinator and workers)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <string>
+# include <vector>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/game.hpp"
+
+
+/**
+ * @brief Count the positions reached after depth moves for each root move, on worker processes
+ * @note The tree is split into jobs (a FEN and a depth), sent one at a time to each worker
+ * that connects. The job of a worker that disconnects, or that says nothing for 30 seconds (the workers send
+ * a heartbeat every 5 seconds), is given to another one; a job that loses 3 workers stops the run.
+ * Protocol (one line per message): "JOB <id> <depth> <FEN>", answered by "DONE <id> <nodes>", then "QUIT";
+ * the workers also send "ALIVE" every 5 seconds
+ * @throw std::runtime_error If the socket or the checkpoint cannot be used, or if a job lost too many workers
+ *
+ * @param game The game to explore (it is given back unchanged)
+ * @param depth The number of moves to play
+ * @param address Where the workers connect: "unix:<path>" or "<host>:<port>" (":<port>" is the loopback,
+ * "*:<port>" every interface)
+ * @param checkpoint The file where the finished jobs are written, and read back to resume ("": none)
+ * @param jobs The number of jobs to reach when splitting the tree
+ * @return vector<long> The number of leaf positions after each move of Game::legalMoves (same order)
+ */
+vector<long> coordinate(Game& game, const int depth, const string& address, const string& checkpoint, const int jobs);
+
+/**
+ * @brief Run the command "chess worker <address> [--threads N] [--hash MB]", without ncurses
+ * @note Connect to a coordinator (see coordinate) and explore its jobs until it says QUIT
+ *
+ * @param argc The number of arguments (after "worker")
+ * @param argv The arguments (after "worker")
+ * @return int The exit code
+ */
+int workerCommand(const int argc, char** argv);
@@ -14,26 +14,170 @@
 
 
 // #### Std inclusions: ####
+# include <algorithm>
+# include <cstdint>
 # include <iostream>
+# include <memory>
 # include <vector>
-# include <unordered_map>
 using namespace std;
 
 // ### Internal inclusions: ####
+# include "../header/bitboard.hpp"
+# include "../header/move.hpp"
 # include "../header/piece.hpp"
 # include "../header/knight.hpp"
 # include "../header/king.hpp"
+# include "../header/queen.hpp"
+# include "../header/pawn.hpp"
+# include "../header/bishop.hpp"
+# include "../header/rook.hpp"
+# include "../header/position.hpp"
+# include "../header/zobrist.hpp"
 
 
-struct HashOperation {
-    size_t operator()(const std::vector<char>& vec) const {
-        size_t hash = 0;
-        for (char c : vec) {
-            // Combine hash values (you can use different combining strategies, like XOR or other bitwise operations)
-            hash ^= std::hash<char>{}(c) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
-        }
-        return hash;
+/**
+ * @brief The state that Game::unmakeMove needs to take back a move
+ *
+ */
+struct Undo
+{
+  uint64_t hash; //< The key of the position before the move
+  Move move; //< The played move
+  uint8_t castling; //< The castling rights before the move
+  int8_t enPassant; //< The en passant square before the move (-1 if none)
+  int16_t fiftyMoves; //< The 50 moves rule counter before the move
+  int8_t captured; //< The kind of the eaten piece (see PieceType, -1 if none)
+};
+
+
+/**
+ * @brief The Piece objects of a game, only created when a square is asked (see Game::at)
+ * @note A facade follows its piece when it moves. The facades that leave the board (eaten or promoted)
+ * are kept until their move is taken back or the game is cleared, so that their pointers stay valid.
+ * The objects are built in the slots of one block, allocated with the game: the slots are found by index
+ * (the squares and the free and retired lists hold indexes), so no pointer is converted back to its slot
+ *
+ */
+struct Facades
+{
+  /**
+   * @brief The memory of one Piece object, of any kind
+   *
+   */
+  struct Slot
+  {
+    alignas(Pawn) alignas(Knight) alignas(Bishop) alignas(Rook) alignas(Queen) alignas(King)
+    unsigned char storage[max({sizeof(Pawn), sizeof(Knight), sizeof(Bishop), sizeof(Rook), sizeof(Queen), sizeof(King)})]; //< Where the object is built (placement new)
+    Piece* piece = nullptr; //< The object built in storage (nullptr if the slot is free)
+    uint32_t ply = 0; //< The index in the history of the move that made the piece leave the board (if retired)
+    int8_t next = -1; //< The next slot of the free or of the retired list (-1: none)
+  };
+
+  static const int SLOTS = 48; //< 32 pieces and 16 promotions: the most Piece objects that a game needs (see checkPosition)
+
+  int8_t squares[64]; //< The slot of the facade of each square (-1 if the square is empty or was never asked)
+  int8_t retired = -1; //< The facades that left the board, the last one first
+  int8_t free = 0; //< The slots that can be used
+  Slot slots[SLOTS];
+
+  Facades() noexcept;
+
+  Facades(const Facades&) = delete;
+  Facades& operator=(const Facades&) = delete;
+
+  ~Facades();
+
+  /**
+   * @brief To get the facade of a square
+   *
+   * @param square The square
+   * @return Piece* nullptr if there is none
+   */
+  Piece* at(const int square) const noexcept
+  {
+    return squares[square] < 0 ? nullptr : slots[squares[square]].piece;
+  }
+
+  /**
+   * @brief To get a free slot, to build a Piece object in
+   * @throw std::runtime_error If every slot is used (a game that checkPosition would reject)
+   *
+   * @return int The index of the slot
+   */
+  int allocate();
+
+  /**
+   * @brief Destroy a Piece object and give its slot back
+   *
+   * @param slot The index of its slot
+   */
+  void release(const int slot) noexcept;
+
+  /**
+   * @brief Destroy every Piece object and give every slot back
+   *
+   */
+  void clear() noexcept;
+};
+
+
+/**
+ * @brief The CheckList class is the list of the pieces that check a king, that never allocates
+ * @note A legal position has two checkers at most
+ *
+ */
+class CheckList
+{
+public:
+  // #### Public attributes: ####
+  static const int CAPACITY = 2;
+
+  // #### Getters: ####
+
+  int size() const noexcept
+  {
+    return _size;
+  }
+
+  bool empty() const noexcept
+  {
+    return not _size;
+  }
+
+  Piece* operator[](const int index) const noexcept
+  {
+    return _pieces[index];
+  }
+
+  Piece* const* begin() const noexcept
+  {
+    return _pieces;
+  }
+
+  Piece* const* end() const noexcept
+  {
+    return _pieces + _size;
+  }
+
+  // #### Setters: ####
+
+  /**
+   * @brief Append a piece (ignored if the list is full)
+   *
+   * @param piece The checking piece
+   */
+  void push_back(Piece* piece) noexcept
+  {
+    if (_size < CAPACITY)
+    {
+      _pieces[_size ++] = piece;
     }
+  }
+
+private:
+  // #### Attributes: ####
+  Piece* _pieces[CAPACITY] = {};
+  int _size = 0;
 };
 
 
@@ -50,7 +194,7 @@ public:
   // #### Constructors: ####
 
   /**
-   * @brief Construct a new Game object
+   * @brief Construct a new Game object (at the starting position)
    * 
    */
   Game();
@@ -63,6 +207,13 @@ public:
    */
   Game(string path);
 
+  /**
+   * @brief Construct a new Game object from a position (see setPosition)
+   *
+   * @param position The position
+   */
+  explicit Game(const Position& position);
+
   // #### Destructor: ####
 
   /**
@@ -74,11 +225,11 @@ public:
   // #### Getters: ####
 
   /**
-   * @brief To get the board of the game
+   * @brief To get the board of the game, without copy
    * 
-   * @return vector<vector<Piece*>> 
+   * @return const Board& The piece code of each square (NO_PIECE if empty)
    */
-  vector<vector<Piece*>> board() const noexcept;
+  const Board& board() const noexcept;
 
   /**
    * @brief To get the player that has to play
@@ -88,19 +239,27 @@ public:
 
   /**
    * @brief To get the chess piece at pos (x, y)
+   * @note The Piece object is created the first time its square is asked (see Facades)
    * 
    * @param x The x pos (col) of the piece
    * @param y The y pos (row) of the piece
    * @return Piece* Pointer to the piece (nullptr if the pos is empty)
    */
-  Piece* at(const int x, const int y) const noexcept;
+  Piece* at(const int x, const int y) const;
 
   /**
    * @brief To get the pieces that are checking the current king
    * 
-   * @return vector<Piece*>
+   * @return CheckList
    */
-  vector<Piece*> checkList() const noexcept;
+  CheckList checkList() const;
+
+  /**
+   * @brief To get the pieces that are checking the king of the current player
+   *
+   * @return Bitboard
+   */
+  Bitboard checkers() const noexcept;
 
   /**
    * @brief To get the king of a player
@@ -108,7 +267,41 @@ public:
    * @param player The owner of the king (0: White, 1: Black)
    * @return Piece* Pointer to the king
    */
-  Piece* king(const  bool player) const noexcept;
+  Piece* king(const  bool player) const;
+
+  /**
+   * @brief To get the squares occupied by a kind of piece of a player
+   *
+   * @param player The owner of the pieces (0: White, 1: Black)
+   * @param type The kind of the pieces
+   * @return Bitboard
+   */
+  Bitboard pieces(const bool player, const PieceType type) const noexcept;
+
+  /**
+   * @brief To get the squares occupied by the pieces of a player
+   *
+   * @param player The owner of the pieces (0: White, 1: Black)
+   * @return Bitboard
+   */
+  Bitboard occupied(const bool player) const noexcept;
+
+  /**
+   * @brief To get the squares occupied by any piece
+   *
+   * @return Bitboard
+   */
+  Bitboard occupied() const noexcept;
+
+  /**
+   * @brief To get the pieces of a player that attack a square
+   *
+   * @param square The attacked square
+   * @param player The owner of the attackers (0: White, 1: Black)
+   * @param occupancy The occupied squares (used to stop the rays of the sliders)
+   * @return Bitboard
+   */
+  Bitboard attackersTo(const int square, const bool player, const Bitboard occupancy) const noexcept;
 
   /**
    * @brief To get the index of the game (the current progress)
@@ -117,6 +310,20 @@ public:
    */
   int index() const noexcept;
 
+  /**
+   * @brief To get the castling rights that are left
+   *
+   * @return int Bits of CastlingRight
+   */
+  int castling() const noexcept;
+
+  /**
+   * @brief To get the square behind the pawn that just moved two squares forward
+   *
+   * @return int The en passant target square (-1 if none)
+   */
+  int enPassant() const noexcept;
+
   /**
    * @brief To get if there was 50 moves without taking a piece or a pawn advancement
    * 
@@ -127,6 +334,8 @@ public:
 
   /**
    * @brief To get if there was at least 3 identical position during the game
+   * @note Only the positions since the last pawn move or capture are compared,
+   * two plies at a time (the side to move has to be the same)
    * 
    * @return bool 
    */
@@ -134,10 +343,18 @@ public:
 
   /**
    * @brief To get the hash of the current position (using Zobrist method)
+   * @note The key is updated incrementally by every modification of the board
    * 
-   * @return vector<char> A value distinct for each possible position
+   * @return uint64_t The XOR of the keys of the pieces, castling rights, en passant file and side to move
    */
-  vector<char> hash() noexcept;
+  uint64_t hash() const noexcept;
+
+  /**
+   * @brief To get the memory used by the game
+   *
+   * @return size_t The bytes of the game, of its move history and of its Piece objects (if any was asked)
+   */
+  size_t memoryUsage() const noexcept;
 
   /**
    * @brief To get the name of the current game
@@ -146,74 +363,113 @@ public:
    */
   string name() const noexcept;
 
+  /**
+   * @brief To get the current position in Forsyth-Edwards Notation
+   *
+   * @return string
+   */
+  string fen() const;
+
+  /**
+   * @brief To get the current position as a Position (without the history)
+   *
+   * @return Position
+   */
+  Position position() const noexcept;
+
   // #### Setters: ####
 
   void setName(string& newName) noexcept;
 
+  /**
+   * @brief Replace the current position by a position in Forsyth-Edwards Notation
+   * @throw std::runtime_error If the FEN is invalid (the game is not modified): a wrong field (e.g. a castling right
+   * other than KQkq or -), or a position that checkPosition rejects (e.g. a pawn on the first or last row, or an en
+   * passant square that is not behind a pawn of the opponent just pushed two rows)
+   * @note The fields after the placement are optional (White to play, no castling, no en passant)
+   *
+   * @param fen The position (e.g. "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1")
+   */
+  void setFen(const string& fen);
+
+  /**
+   * @brief Replace the current position (the history is lost)
+   * @throw std::runtime_error If the position is invalid (see checkPosition in header/rules.hpp, the game is not modified)
+   *
+   * @param position The position (e.g. from Game::position)
+   */
+  void setPosition(const Position& position);
+
   // #### Methods: ####
 
   /**
-   * @brief Move the piece to a new position
+   * @brief Move the piece to a new position if it is legal, and give the turn to the other player
    * 
    * @param piece The involved piece
    * @param x The x of target position
    * @param y The y of target position
-   * @param force Indiquate if we force the move
+   * @param promotion Magic value between 0 (no promotion) and 4 (see TUI::askPromotion in header/tui.hpp)
+   * @return bool 0 if the move was played, 1 if it is illegal
    */
-  bool move(Piece* piece, const int x, const int y, const bool force = false);
+  bool move(Piece* piece, const int x, const int y, const int promotion = 0);
 
   /**
-   * @brief Return if there is no more legal move to play for current player
-   * 
-   * @return bool
+   * @brief Play a legal move and give the turn to the other player
+   * @note The move is not checked, it has to come from Piece::read
+   *
+   * @param move The move to play
    */
-  bool isMate() noexcept;
+  void makeMove(const Move move);
 
   /**
-   * @brief After a move, update _checkList with new checks
-   * @note Has to be called after Game::move
-   * 
-   * @param piece The involved piece
-   * @param x The x of initial position
-   * @param y The y of initial position
+   * @brief Take back the last move played with makeMove
+   *
    */
-  void updateCheckList(Piece* piece, const int x, const int y) noexcept;
+  void unmakeMove();
 
   /**
-   * @brief Return if (x, y) are between its king and a threat (ROW, COL, DIAG)
-   * 
-   * @param x The X pos
-   * @param y The Y pos
-   * @param player The owner of the king 
-   * @return Piece* The threat (if there is none, nullptr)
+   * @brief To get all the legal moves of the current player
+   * @note The checkers and the pinned pieces are computed once for the whole position (see generateMoves)
+   *
+   * @param moves The list to fill (it is cleared first)
    */
-  Piece* isDiscoveryCheck(const int x, const int y, const bool player) const noexcept;
+  void legalMoves(MoveList& moves) const noexcept;
 
   /**
-   * @brief Promote a chess piece
-   * @throw std::runtime_error If the player try to abort 
+   * @brief To get the number of legal moves of the current player
+   * @note Same as legalMoves, but the moves are counted from the attack masks without being listed
    *
-   * @param piece The involved piece
-   * @param promotion Magic value between 0 and 4 (see TUI::askPromotion in header/tui.hpp)
-   * @return The pointer of the new piece (after promotion)
+   * @return int
    */
-  Piece* promote(Piece* piece, int promotion);
+  int countLegalMoves() const noexcept;
 
   /**
-   * @brief Filter the vector moves to only keeps the legal ones
+   * @brief To get the legal moves of the current player, or of one of its pieces
+   * @note All the moves are read from the shared MoveCache of the thread (computed with legalMoves and remembered
+   * if the position is not in it). The moves of one piece are generated directly, which is faster than a hit
+   *
+   * @param moves The list to fill
+   * @param from Only the moves from this square are read (-1: all of them)
+   */
+  void readMoves(MoveList& moves, const int from = -1) const;
+
+  /**
+   * @brief Return if there is no more legal move to play for current player
+   * @note The legal moves are counted without being listed (see countLegalMoves)
    * 
-   * @param piece The piece that owns the moves
-   * @param moves The vector of pos {x, y} for each moves
+   * @return bool
    */
-  void filterMoves(Piece* piece, vector<vector<int>>& moves);
+  bool isMate();
 
   /**
-   * @brief Helper for filterMoves, erase illegals moves for piece, the king
+   * @brief Return if (x, y) are between its king and a threat (ROW, COL, DIAG)
    * 
-   * @param piece The king
-   * @param moves The moves of the king (vector of pos {x, y})
+   * @param x The X pos
+   * @param y The Y pos
+   * @param player The owner of the king 
+   * @return Piece* The threat (if there is none, nullptr)
    */
-  void filterKingMoves(Piece* piece, vector<vector<int>>& moves);
+  Piece* isDiscoveryCheck(const int x, const int y, const bool player) const;
 
   /**
    * @brief Save the current game into a file
@@ -233,126 +489,122 @@ public:
    */
   bool operator==(const Game& other) const;
 
-  /**
-   * @brief The increment operator
-   * 
-   * @return Game& This game
-   */
-  Game& operator++();
-
 private:
   // #### Attributes: ####
   string _name = "<no name>";
-  vector<vector<Piece*>> _board;
-  vector<Piece*> _checkList; //< The list of piece checking current player
+  Bitboard _pieces[2][6] = {}; //< The squares of each kind of piece, for each player (the board)
+  Bitboard _occupied[2] = {}; //< The squares occupied by each player
+  Board _board; //< The piece on each square (NO_PIECE if empty), filled by clear
   bool _turn = 0; //< The player that is gonna play (0: White, 1: Black)
-  King* _whiteKing = nullptr, * _blackKing = nullptr;
   int _index = 0; //< The index of the current move in the game (from 0 to inf.)
   int _50moveRules = 0; //< The index used in counting the 50 moves rule
-  unordered_map<vector<char>, int, HashOperation> _repetitions; //< Used for the draw by repetition
-  vector<char> _hash; //< Last hash computed
+  int _castling = WHITE_SHORT | WHITE_LONG | BLACK_SHORT | BLACK_LONG; //< The castling rights that are left
+  int _enPassant = -1; //< The square behind the pawn that just moved two squares forward
+  vector<Undo> _history; //< The undo records of the moves played with makeMove (also the keys of the past positions)
+  uint64_t _hash = 0; //< The Zobrist key of the current position
+  mutable unique_ptr<Facades> _facades; //< The Piece objects that were asked (allocated with the game)
+
+  /**
+   * @brief The game seen as the board of applyMove (see header/rules.hpp), the facades follow their pieces
+   *
+   */
+  struct Mover;
 
   // #### Auxiliary methods: ####
 
   /**
-   * @brief Helper for isDiscoveryCheck, check for possible threat on the same row as the king
-   * 
-   * @param x The X pos
-   * @param y The Y pos
+   * @brief Helper for isDiscoveryCheck, return the square of the slider that would check its king if square was empty
+   *
+   * @param square The square that is left
    * @param player The owner of the king
-   * @param king The king that might be in check
-   * @return Piece* The piece that is checking the king (or nullptr if none)
+   * @return int The square of the threat (-1 if none)
    */
-  Piece* discoverRow(const int x, const int y, const bool player, Piece* king) const noexcept;
+  int discoveryThreat(const int square, const bool player) const noexcept;
 
   /**
-   * @brief Helper for isDiscoveryCheck, check for possible threat on the same column as the king
-   * 
-   * @param x The X pos
-   * @param y The Y pos
-   * @param player The owner of the king
-   * @param king The king that might be in check
-   * @return Piece* The piece that is checking the king (or nullptr if none)
+   * @brief Helper for discoveryThreat, return the slider that is behind square seen from the king
+   *
+   * @param square The square that is left
+   * @param kingSquare The square of the king that might be in check
+   * @param sliders The enemy pieces that can slide along the line between the king and square
+   * @param diagonal If the line is a diagonal (else a row or a column)
+   * @return int The square of the piece that is checking the king once square is empty (-1 if none)
    */
-  Piece* discoverCol(const int x, const int y, const bool player, Piece* king) const noexcept;
+  int discover(const int square, const int kingSquare, const Bitboard sliders, const bool diagonal) const noexcept;
 
   /**
-   * @brief Helper for isDiscoveryCheck, check for possible threat on the same diagonal (A) as the king
-   * 
-   * @param x The X pos
-   * @param y The Y pos
-   * @param player The owner of the king
-   * @param king The king that might be in check
-   * @return Piece* The piece that is checking the king (or nullptr if none)
+   * @brief To get the square of the king of a player
+   *
+   * @param player The owner of the king (0: White, 1: Black)
+   * @return int
    */
-  Piece* discoverDiagA(const int x, const int y, const bool player, Piece* king) const noexcept;
+  int kingSquare(const bool player) const noexcept;
 
   /**
-   * @brief Helper for isDiscoveryCheck, check for possible threat on the same diagonal (B) as the king
-   * 
-   * @param x The X pos
-   * @param y The Y pos
-   * @param player The owner of the king
-   * @param king The king that might be in check
-   * @return Piece* The piece that is checking the king (or nullptr if none)
+   * @brief To get the Piece object of a square (created the first time, see Facades)
+   *
+   * @param square The square
+   * @return Piece* nullptr if the square is empty
    */
-  Piece* discoverDiagB(const int x, const int y, const bool player, Piece* king) const noexcept;
+  Piece* facade(const int square) const;
 
   /**
-   * @brief Helper for filterMoves, erase illegals moves for piece, that is not the king
-   * 
-   * @param piece The involved chess piece
-   * @param moves The moves of the king (vector of pos {x, y})
+   * @brief Move the facade of a square away from the board (see Facades)
+   *
+   * @param square The square of the facade
+   * @param ply The index in the history of the move that made it leave
    */
-  void filterNotKingMoves(Piece* piece, vector<vector<int>>& moves);
+  void retire(const int square, const size_t ply);
 
   /**
-   * @brief Helper for filterMoves, check if En Passant is in moves, and erase it if illegal
-   * 
-   * @param pawn The pawn 
-   * @param moves The moves of the pawn
+   * @brief Put back on its square the last retired facade, if it left the board during ply
+   *
+   * @param square The square of the facade
+   * @param player The owner of the facade
+   * @param ply The index in the history of the move that is taken back
    */
-  void filterEnPassant(Piece* pawn, vector<vector<int>>& moves);
+  void restore(const int square, const bool player, const size_t ply) noexcept;
 
   /**
-   * @brief Helper for filterKingMoves, return if a knight is near the king
-   * 
-   * @param piece The involved king
-   * @return bool
+   * @brief Delete all the pieces and reset the state of the game
+   *
    */
-  bool knightNear(Piece* piece);
+  void clear() noexcept;
 
   /**
-   * @brief Helper for filterKingMoves, return if a queen and rook is near the king
-   * 
-   * @param piece The involved king
-   * @return bool
+   * @brief Move a piece in the bitboards (and its facade, if any), the target has to be empty
+   *
+   * @param player The owner of the piece
+   * @param type The kind of the piece
+   * @param from The origin square
+   * @param to The target square
    */
-  bool rookAndQueenNear(Piece* piece);
+  void relocate(const bool player, const PieceType type, const int from, const int to) noexcept;
 
   /**
-   * @brief Helper for filterKingMoves, return if a queen or bishop is near the king
-   * 
-   * @param piece The involved king
-   * @return bool
+   * @brief To get the part of the Zobrist key that does not come from the pieces
+   *
+   * @return uint64_t The keys of the castling rights, en passant file and side to move
    */
-  bool bishopAndQueenNear(Piece* piece);
+  uint64_t stateKey() const noexcept;
 
   /**
-   * @brief Helper for filterKingMoves, return if a pawn is near the king
-   * 
-   * @param piece The involved king
-   * @return bool
+   * @brief Add a piece to the bitboards (and to the Zobrist key)
+   *
+   * @param player The owner of the piece
+   * @param type The kind of the piece
+   * @param square The square of the piece
    */
-  bool pawnNear(Piece* piece);
+  void place(const bool player, const PieceType type, const int square) noexcept;
 
   /**
-   * @brief Helper for filterKingMoves, return if a king is near the king
-   * 
-   * @param piece The involved king
-   * @return bool
+   * @brief Remove a piece from the bitboards (and from the Zobrist key)
+   *
+   * @param player The owner of the piece
+   * @param type The kind of the piece
+   * @param square The square of the piece
    */
-  bool kingNear(Piece* piece);
+  void lift(const bool player, const PieceType type, const int square) noexcept;
 
   /**
    * @brief Initialize the _turn attribute from a save file
@@ -376,14 +628,14 @@ private:
   void init50moves(ifstream& file);
 
   /**
-   * @brief Initialize the _board attribute from a save file
+   * @brief Initialize the pieces from a save file
    * 
    * @param file The file object
    */
   void initBoard(ifstream& file);
 
   /**
-   * @brief Initialize the _checkList attribute from a save file
+   * @brief Check the checks of a save file (they are recomputed from the board)
    * 
    * @param file The file object
    */
@@ -417,14 +669,14 @@ private:
   void write50moves(ofstream& file);
 
   /**
-   * @brief Write the _board attribute to a save file
+   * @brief Write the pieces to a save file
    * 
    * @param file The file object
    */
   void writeBoard(ofstream& file);
 
   /**
-   * @brief Write the _checkList attribute to a save file
+   * @brief Write the checks of the current player to a save file
    * 
    * @param file The file object
    */
@@ -15,7 +15,6 @@
 
 // #### Internal inclusions: ####
 # include "../header/piece.hpp"
-# include "../header/rook.hpp"
 
 // #### Std inclusions: ####
 # include <iostream>
@@ -45,36 +44,21 @@ public:
    * @param x The X pos of the chess piece
    * @param y The Y pos of the chess piece
    * @param game The game where the chess piece is located
-   * @param didntMove The flag didntMove of the king
    */
-  King(const bool player, const int x, const int y, Game* game, bool didntMove = true);
+  King(const bool player, const int x, const int y, Game* game);
 
   // #### Flags: ####
 
-  /**
-   * @brief To get the King flag
-   * 
-   * @return true
-   */
-  bool isKing() const noexcept override;
-
   /**
    * @brief To get the didntMove flag
    * 
-   * @return true If the king hasnt moved yet
+   * @return true If the king hasnt moved yet (and can still castle on a side, see Game::castling)
    * @return false Else
    */
   bool didntMove() const noexcept;
 
   // #### Methods: ####
 
-  /**
-   * @brief To get the list of legal moves for the king
-   * 
-   * @return vector<vector<int, int>> The list of pos that the king can hop on
-   */
-  vector<vector<int>> read() noexcept override;
-
   /**
    * @brief Return if the king threatens another piece
    * 
@@ -83,21 +67,6 @@ public:
    */
   bool threat(Piece* piece) override;
 
-  /**
-   * @brief Move the king to (x, y)
-   *
-   * @param x The new X pos to assign to the chess piece
-   * @param y The new Y pos to assign to the chess piece
-   */
-  void move(const int x, const int y) noexcept override;
-
-  /**
-   * @brief Check for the short and long castling and add them
-   * to _savedMoves if they are legal
-   * 
-   */
-  void readCastling() noexcept;
-
   // #### Operator: ####
 
   /**
@@ -108,17 +77,4 @@ public:
    * @return ostream& The modified stream
    */
   friend ostream& operator<<(ostream& stream, const King& me);
-
-private:
-  // #### Attributes: ####
-  bool _didntMove = true;
-
-  /**
-   * @brief Helper of King::readCastling, return if the castling is legal
-   * @note This method does not check: K and R didnt move, K not in check, R exists 
-   *
-   * @param rook The rook involved in the castling
-   * @return bool
-   */
-  bool castlingLegal(Rook* rook) const noexcept;
 };
\ No newline at end of file
@@ -47,24 +47,8 @@ public:
    */
   Knight(const bool player, const int x, const int y, Game* game);
 
-  // #### Flags: ####
-
-  /**
-   * @brief To get the Knight flag
-   * 
-   * @return true
-   */
-  bool isKnight() const noexcept override;
-
   // #### Methods: ####
 
-  /**
-   * @brief To get the list of legal moves for the knight
-   * 
-   * @return vector<vector<int, int>> The list of pos that the knight can hop on
-   */
-  vector<vector<int>> read() noexcept override;
-
   /**
    * @brief Return if the knight threatens another piece
    * 
@@ -0,0 +1,242 @@
+/**
+ * @file move.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the Move and MoveList classes
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <cstdint>
+# include <string>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/bitboard.hpp"
+
+
+/**
+ * @brief The Move class represents a move packed in 16 bits
+ * @note Bits 0-5: origin square, bits 6-11: target square, bits 12-15: flag
+ *
+ */
+class Move
+{
+public:
+  // #### Flags: ####
+  enum Flag : uint16_t
+  {
+    QUIET = 0,
+    DOUBLE_PUSH = 1,
+    CASTLING = 2,
+    EN_PASSANT = 3,
+    PROMOTION_QUEEN = 4, //< The promotions follow the order of TUI::askPromotion (Queen, Rook, Bishop, Knight)
+    PROMOTION_ROOK = 5,
+    PROMOTION_BISHOP = 6,
+    PROMOTION_KNIGHT = 7
+  };
+
+  // #### Constructors: ####
+
+  /**
+   * @brief Construct an uninitialized Move object (so that a MoveList costs nothing to create)
+   *
+   */
+  Move() noexcept = default;
+
+  /**
+   * @brief Construct a new Move object
+   *
+   * @param from The origin square
+   * @param to The target square
+   * @param flag The kind of move
+   */
+  constexpr Move(const int from, const int to, const Flag flag = QUIET) noexcept:
+  _data(uint16_t(from | (to << 6) | (flag << 12)))
+  {}
+
+  // #### Getters: ####
+
+  /**
+   * @brief To get the origin square
+   *
+   * @return int
+   */
+  constexpr int from() const noexcept
+  {
+    return _data & 0x3f;
+  }
+
+  /**
+   * @brief To get the target square
+   *
+   * @return int
+   */
+  constexpr int to() const noexcept
+  {
+    return (_data >> 6) & 0x3f;
+  }
+
+  /**
+   * @brief To get the kind of move
+   *
+   * @return Flag
+   */
+  constexpr Flag flag() const noexcept
+  {
+    return Flag(_data >> 12);
+  }
+
+  /**
+   * @brief To get the x pos (col) of the target square
+   *
+   * @return int
+   */
+  constexpr int x() const noexcept
+  {
+    return squareX(to());
+  }
+
+  /**
+   * @brief To get the y pos (row) of the target square
+   *
+   * @return int
+   */
+  constexpr int y() const noexcept
+  {
+    return squareY(to());
+  }
+
+  /**
+   * @brief To get the promotion of the move
+   *
+   * @return int Magic value between 0 (no promotion) and 4 (see TUI::askPromotion in header/tui.hpp)
+   */
+  constexpr int promotion() const noexcept
+  {
+    return flag() >= PROMOTION_QUEEN ? flag() - PROMOTION_QUEEN + 1 : 0;
+  }
+
+  /**
+   * @brief To get the move in coordinate notation (e.g. e2e4, e7e8q)
+   *
+   * @return string
+   */
+  string str() const
+  {
+    string output = {char('a' + squareX(from())), char('8' - squareY(from())), char('a' + x()), char('8' - y())};
+    if (promotion())
+    {
+      output.push_back("qrbn"[promotion() - 1]);
+    }
+    return output;
+  }
+
+  // #### Operators: ####
+
+  constexpr bool operator==(const Move& other) const noexcept
+  {
+    return _data == other._data;
+  }
+
+  constexpr bool operator!=(const Move& other) const noexcept
+  {
+    return _data != other._data;
+  }
+
+private:
+  // #### Attributes: ####
+  uint16_t _data;
+};
+
+
+/**
+ * @brief The MoveList class is a list of moves with a fixed capacity, that never allocates
+ * @note 256 is more than the number of legal moves of any chess position (218)
+ *
+ */
+class MoveList
+{
+public:
+  // #### Public attributes: ####
+  static const int CAPACITY = 256;
+
+  // #### Getters: ####
+
+  int size() const noexcept
+  {
+    return _size;
+  }
+
+  bool empty() const noexcept
+  {
+    return not _size;
+  }
+
+  Move operator[](const int index) const noexcept
+  {
+    return _moves[index];
+  }
+
+  const Move* begin() const noexcept
+  {
+    return _moves;
+  }
+
+  const Move* end() const noexcept
+  {
+    return _moves + _size;
+  }
+
+  /**
+   * @brief To get the first move that goes to a square
+   *
+   * @param to The target square
+   * @return const Move* Pointer to the move (nullptr if there is none)
+   */
+  const Move* find(const int to) const noexcept
+  {
+    for (const Move& move : *this)
+    {
+      if (move.to() == to)
+      {
+        return &move;
+      }
+    }
+    return nullptr;
+  }
+
+  // #### Setters: ####
+
+  void push_back(const Move move) noexcept
+  {
+    _moves[_size ++] = move;
+  }
+
+  void clear() noexcept
+  {
+    _size = 0;
+  }
+
+  /**
+   * @brief Erase a move by replacing it with the last one (the order is not kept)
+   *
+   * @param index The index of the erased move
+   */
+  void remove(const int index) noexcept
+  {
+    _moves[index] = _moves[-- _size];
+  }
+
+private:
+  // #### Attributes: ####
+  Move _moves[CAPACITY];
+  int _size = 0;
+};
@@ -0,0 +1,140 @@
+/**
+ * @file movecache.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the MoveCache class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <cstddef>
+# include <cstdint>
+# include <memory>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/move.hpp"
+# include "../header/position.hpp"
+
+
+/**
+ * @brief The MoveCache class remembers the legal moves of the last positions, for every game of a thread
+ * @note The entries are one fixed array, split in sets of WAYS entries: a position can only be in the set
+ * chosen by its Zobrist key, then the whole position is compared, so a collision is a miss. Nothing is allocated
+ * after the construction. When its set is full, the clock of the set picks the entry to replace (each set
+ * has its own hand, and an entry that was found since the last pass of the hand gets a second chance).
+ * A cache is not synchronized: each thread has its own shared cache
+ *
+ */
+class MoveCache
+{
+public:
+  // #### Public attributes: ####
+  static constexpr size_t ENTRIES = 256; //< The entries of each shared cache (about 150 KB)
+  static constexpr size_t WAYS = 4; //< The entries of a set
+
+  // #### Constructors: ####
+
+  /**
+   * @brief Construct a new MoveCache object
+   *
+   * @param entries The number of positions that are remembered (rounded up to a power of two, at least WAYS)
+   */
+  MoveCache(const size_t entries);
+
+  MoveCache(const MoveCache&) = delete;
+  MoveCache& operator=(const MoveCache&) = delete;
+
+  // #### Getters: ####
+
+  /**
+   * @brief To get the cache shared by the games of the calling thread
+   *
+   * @return MoveCache&
+   */
+  static MoveCache& shared();
+
+  /**
+   * @brief To get the memory used by the cache
+   *
+   * @return size_t The size in bytes
+   */
+  size_t bytes() const noexcept;
+
+  // #### Methods: ####
+
+  /**
+   * @brief Look for the legal moves of a position
+   * @note Only the pieces, the player to move, the castling rights and the en passant square are compared
+   *
+   * @param position The position
+   * @param moves The legal moves (only written if found)
+   * @param from Only the moves from this square are written (-1: all of them)
+   * @return bool If the position was found
+   */
+  bool find(const Position& position, MoveList& moves, const int from = -1);
+
+  /**
+   * @brief Remember the legal moves of a position (an entry is replaced if the cache is full)
+   *
+   * @param position The position
+   * @param moves Its legal moves (see Game::legalMoves)
+   */
+  void store(const Position& position, const MoveList& moves);
+
+  /**
+   * @brief Forget a position (nothing happens if it is not remembered)
+   *
+   * @param position The position
+   */
+  void erase(const Position& position);
+
+  /**
+   * @brief Forget every position
+   *
+   */
+  void clear();
+
+private:
+  /**
+   * @brief A position and its legal moves
+   *
+   */
+  struct Entry
+  {
+    Position position; //< The key of the entry
+    MoveList moves; //< The legal moves of position
+    bool used = false; //< If the entry holds a position
+    bool referenced = false; //< If the entry was found since the hand passed on it
+  };
+
+  // #### Attributes: ####
+  unique_ptr<Entry[]> _entries;
+  size_t _size; //< The number of entries (a power of two)
+  unique_ptr<uint8_t[]> _hands; //< The next way considered for replacement, in each set
+
+  // #### Auxiliary methods: ####
+
+  /**
+   * @brief To get the first entry of the set of a position
+   *
+   * @param hash The Zobrist key of the position
+   * @return Entry*
+   */
+  Entry* set(const uint64_t hash) const noexcept;
+
+  /**
+   * @brief To get the entry of a position
+   *
+   * @param position The position
+   * @return Entry* nullptr if the position is not remembered
+   */
+  Entry* entry(const Position& position) noexcept;
+};
@@ -44,19 +44,11 @@ public:
    * @param x The X pos of the chess piece
    * @param y The Y pos of the chess piece
    * @param game The game where the chess piece is located
-   * @param doubleUp The index of the double up of the pawn
    */
-  Pawn(const bool player, const int x, const int y, Game* game, int doubleUp = -1);
+  Pawn(const bool player, const int x, const int y, Game* game);
 
   // #### Flags: ####
 
-  /**
-   * @brief To get the Pawn flag
-   * 
-   * @return true
-   */
-  bool isPawn() const noexcept override;
-
   /**
    * @brief To get the didntMove flag
    * 
@@ -69,30 +61,14 @@ public:
 
   /**
    * @brief To get the index of the 'double up' move
+   * @note Only the last one is known (see Game::enPassant), an older one gives -2
    * 
-   * @return int 
+   * @return int -1 if the pawn didnt move, -2 if the index is unknown
    */
   int doubleUpIndex() const noexcept;
 
-  // #### Setters: ####
-
-  /**
-   * @brief Check if the move is legal and execute it
-   *
-   * @param x The new X pos to assign to the chess piece
-   * @param y The new Y pos to assign to the chess piece
-   */
-  void move(const int x, const int y) noexcept override;
-
   // #### Methods: ####
 
-  /**
-   * @brief To get the list of legal moves for the pawn
-   * 
-   * @return vector<vector<int, int>> The list of pos that the pawn can hop on
-   */
-  vector<vector<int>> read() noexcept override;
-
   /**
    * @brief Return if the pawn threatens another piece
    * @note Since this method is primarely used for checks, it does not support En passant
@@ -112,8 +88,4 @@ public:
    * @return ostream& The modified stream
    */
   friend ostream& operator<<(ostream& stream, const Pawn& me);
-
-private:
-  // #### Attributes: ####
-  int _doubleUp = -1;
 };
\ No newline at end of file
@@ -0,0 +1,116 @@
+/**
+ * @file perfcounters.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the PerfCounters class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <cstdint>
+# include <string>
+using namespace std;
+
+
+/**
+ * @brief The PerfCounters class reads the hardware counters of the CPU for the current thread (Linux perf_event_open)
+ * @note Each counter is opened on its own, so that the ones that the CPU (or the container)
+ * does not provide are simply missing. Without any counter, available() is false and every read is 0
+ *
+ */
+class PerfCounters
+{
+public:
+  // #### Events: ####
+  enum Event
+  {
+    CYCLES,
+    INSTRUCTIONS,
+    L1_MISSES, //< Reads that missed the L1 data cache
+    LLC_MISSES, //< Accesses that missed the last level cache
+    BRANCH_MISSES,
+    EVENTS //< The number of events
+  };
+
+  // #### Constructors: ####
+
+  /**
+   * @brief Construct a new PerfCounters object (the counters are opened, but not started)
+   *
+   */
+  PerfCounters() noexcept;
+
+  PerfCounters(const PerfCounters&) = delete;
+  PerfCounters& operator=(const PerfCounters&) = delete;
+
+  // #### Destructor: ####
+
+  ~PerfCounters() noexcept;
+
+  // #### Getters: ####
+
+  /**
+   * @brief To get if at least one counter could be opened
+   *
+   * @return bool
+   */
+  bool available() const noexcept;
+
+  /**
+   * @brief To get if a counter could be opened
+   *
+   * @param event The counter
+   * @return bool
+   */
+  bool available(const Event event) const noexcept;
+
+  /**
+   * @brief To get why the first missing counter could not be opened
+   *
+   * @return string The error of perf_event_open ("" if every counter is available)
+   */
+  string error() const noexcept;
+
+  /**
+   * @brief To get the value of a counter between the last start and stop
+   * @note The value is scaled up when the kernel had to share the hardware between several counters
+   *
+   * @param event The counter
+   * @return uint64_t 0 if the counter is not available
+   */
+  uint64_t read(const Event event) const noexcept;
+
+  /**
+   * @brief To get the name of an event
+   *
+   * @param event The event
+   * @return const char*
+   */
+  static const char* name(const Event event) noexcept;
+
+  // #### Methods: ####
+
+  /**
+   * @brief Reset the counters and start counting
+   *
+   */
+  void start() noexcept;
+
+  /**
+   * @brief Stop counting (the values are kept until the next start)
+   *
+   */
+  void stop() noexcept;
+
+private:
+  // #### Attributes: ####
+  int _descriptors[EVENTS]; //< -1 for the counters that are not available
+  string _error;
+};
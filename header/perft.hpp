@@ -0,0 +1,78 @@
+/**
+ * @file perft.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the perft script
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <vector>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/game.hpp"
+# include "../header/perfttable.hpp"
+
+
+/**
+ * @brief Count the positions reached after depth moves (performance test of the move generation)
+ *
+ * @param game The game to explore (it is given back unchanged)
+ * @param depth The number of moves to play
+ * @param table The node counts of the subtrees already explored (nullptr: none)
+ * @return long The number of leaf positions
+ */
+long perft(Game& game, const int depth, PerftTable* table = nullptr) noexcept;
+
+/**
+ * @brief A subtree of a perft: the moves from the root to its position
+ *
+ */
+struct Subtree
+{
+  int root; //< The index of its root move (in Game::legalMoves)
+  vector<Move> path; //< The moves from the root position (the root move first)
+};
+
+/**
+ * @brief Split a perft tree at the root and the next plies, until there is enough subtrees
+ * @note The subtrees always leave at least one move to play, and are given in a stable order
+ *
+ * @param game The game to split (it is given back unchanged)
+ * @param depth The depth of the perft (at least 1)
+ * @param count The number of subtrees to reach (if the depth allows it)
+ * @return vector<Subtree>
+ */
+vector<Subtree> split(Game& game, const int depth, const size_t count);
+
+/**
+ * @brief Count the positions reached after depth moves for each root move, on several threads
+ * @note The tree is split at the root and the next plies into tasks for a work-stealing
+ * ThreadPool, each thread explores its tasks on its own game, built from the Position of the root (see Game::position)
+ *
+ * @param game The game to explore (it is given back unchanged)
+ * @param depth The number of moves to play
+ * @param threads The number of threads (0: one per core)
+ * @param table The node counts of the subtrees already explored, shared by the threads (nullptr: none)
+ * @return vector<long> The number of leaf positions after each move of Game::legalMoves (same order)
+ */
+vector<long> divide(Game& game, const int depth, const int threads = 0, PerftTable* table = nullptr);
+
+/**
+ * @brief Run the command "chess perft <depth> [FEN] [--threads N] [--hash MB]", without ncurses
+ * @note Print the nodes of each root move (divide), the total and the nodes per second.
+ * With "--listen <address> [--checkpoint FILE] [--jobs N]", the tree is explored by worker processes (see coordinate)
+ *
+ * @param argc The number of arguments (after "perft")
+ * @param argv The arguments (after "perft")
+ * @return int The exit code
+ */
+int perftCommand(const int argc, char** argv);
@@ -0,0 +1,116 @@
+/**
+ * @file perfttable.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the PerftTable class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <atomic>
+# include <cstddef>
+# include <cstdint>
+# include <memory>
+using namespace std;
+
+
+/**
+ * @brief The PerftTable class remembers the node counts of the subtrees (transposition table)
+ * @note The table has a fixed size and can be shared by several threads without lock:
+ * each entry stores its key XORed with its data, so a torn entry is seen as a miss
+ *
+ */
+class PerftTable
+{
+public:
+  // #### Constructors: ####
+
+  /**
+   * @brief Construct a new PerftTable object
+   * @throw std::bad_alloc If the memory cannot be allocated
+   *
+   * @param megabytes The memory of the table (rounded down to a power of two, at least one bucket)
+   */
+  PerftTable(const size_t megabytes);
+
+  PerftTable(const PerftTable&) = delete;
+  PerftTable& operator=(const PerftTable&) = delete;
+
+  // #### Getters: ####
+
+  /**
+   * @brief To get the memory used by the table
+   *
+   * @return size_t The size in bytes
+   */
+  size_t bytes() const noexcept;
+
+  // #### Methods: ####
+
+  /**
+   * @brief Look for the node count of a position
+   *
+   * @param key The Zobrist key of the position (see Game::hash)
+   * @param depth The depth of the subtree
+   * @param nodes The node count (only written if found)
+   * @return bool If the subtree was found
+   */
+  bool probe(const uint64_t key, const int depth, uint64_t& nodes) const noexcept;
+
+  /**
+   * @brief Remember the node count of a position
+   *
+   * @param key The Zobrist key of the position (see Game::hash)
+   * @param depth The depth of the subtree
+   * @param nodes The node count
+   */
+  void store(const uint64_t key, const int depth, const uint64_t nodes) noexcept;
+
+  /**
+   * @brief Forget every entry
+   *
+   */
+  void clear() noexcept;
+
+private:
+  /**
+   * @brief An entry: data is (nodes << 8) | depth, check is key ^ data
+   *
+   */
+  struct Entry
+  {
+    atomic<uint64_t> check;
+    atomic<uint64_t> data;
+  };
+
+  /**
+   * @brief A bucket: the first entry keeps the deepest subtree, the second one the newest
+   *
+   */
+  struct Bucket
+  {
+    Entry entries[2];
+  };
+
+  // #### Attributes: ####
+  unique_ptr<Bucket[]> _buckets;
+  size_t _mask = 0; //< The number of buckets minus one
+
+  // #### Auxiliary methods: ####
+
+  /**
+   * @brief To get the bucket of a subtree
+   *
+   * @param key The Zobrist key of the position
+   * @param depth The depth of the subtree
+   * @return Bucket&
+   */
+  Bucket& bucket(const uint64_t key, const int depth) const noexcept;
+};
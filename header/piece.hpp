@@ -14,14 +14,80 @@
 
 
 // #### Std inclusions: ####
+# include <cstdint>
 # include <iostream>
 # include <vector>
 using namespace std;
 
+// #### Internal inclusions: ####
+# include "../header/bitboard.hpp"
+# include "../header/move.hpp"
+
 
 class Game; //< Cannot use game.hpp because of circular import
 
 
+/**
+ * @brief The kind of a chess piece (used to index the bitboards of a game)
+ *
+ */
+enum PieceType
+{
+  PAWN,
+  KNIGHT,
+  BISHOP,
+  ROOK,
+  QUEEN,
+  KING
+};
+
+
+/**
+ * @brief A chess piece in one byte: its PieceType in the bits 0-2 and its owner in the bit 3
+ *
+ */
+typedef uint8_t PieceCode;
+
+const PieceCode NO_PIECE = 0xff; //< The code of an empty square
+
+
+/**
+ * @brief To get the code of a piece
+ *
+ * @param player The owner of the piece (0: White, 1: Black)
+ * @param type The kind of the piece
+ * @return PieceCode
+ */
+constexpr PieceCode pieceCode(const bool player, const PieceType type) noexcept
+{
+  return PieceCode(player << 3 | type);
+}
+
+
+/**
+ * @brief To get the kind of a piece from its code (not NO_PIECE)
+ *
+ * @param code The code of the piece
+ * @return PieceType
+ */
+constexpr PieceType codeType(const PieceCode code) noexcept
+{
+  return PieceType(code & 7);
+}
+
+
+/**
+ * @brief To get the owner of a piece from its code (not NO_PIECE)
+ *
+ * @param code The code of the piece
+ * @return bool 0 if White, 1 if Black
+ */
+constexpr bool codePlayer(const PieceCode code) noexcept
+{
+  return code >> 3;
+}
+
+
 /**
  * @brief The class Piece represents a piece in a chess game
  * 
@@ -85,6 +151,20 @@ public:
    */
   char repr() const noexcept;
 
+  /**
+   * @brief To get the kind of the chess piece
+   *
+   * @return PieceType
+   */
+  PieceType type() const noexcept;
+
+  /**
+   * @brief To get the kind and the owner of the chess piece in one byte
+   *
+   * @return PieceCode
+   */
+  PieceCode code() const noexcept;
+
   /**
    * @brief To get a pointer to the game where the chess piece
    * is sitting
@@ -94,6 +174,7 @@ public:
   Game* game() const noexcept;
 
   // #### Flags: ####
+  // They read the code of the piece, so they are not virtual
 
   /**
    * @brief To get the King flag
@@ -101,7 +182,7 @@ public:
    * @return true If the piece is a king
    * @return false Else
    */
-  virtual bool isKing() const noexcept;
+  bool isKing() const noexcept;
 
   /**
    * @brief To get the Queen flag
@@ -109,7 +190,7 @@ public:
    * @return true If the piece is a queen
    * @return false Else
    */
-  virtual bool isQueen() const noexcept;
+  bool isQueen() const noexcept;
 
   /**
    * @brief To get the Rook flag
@@ -117,7 +198,7 @@ public:
    * @return true If the piece is a rook
    * @return false Else
    */
-  virtual bool isRook() const noexcept;
+  bool isRook() const noexcept;
 
   /**
    * @brief To get the Knight flag
@@ -125,7 +206,7 @@ public:
    * @return true If the piece is a knight
    * @return false Else
    */
-  virtual bool isKnight() const noexcept;
+  bool isKnight() const noexcept;
 
   /**
    * @brief To get the Bishop flag
@@ -133,7 +214,7 @@ public:
    * @return true If the piece is a bishop
    * @return false Else
    */
-  virtual bool isBishop() const noexcept;
+  bool isBishop() const noexcept;
 
   /**
    * @brief To get the Pawn flag
@@ -141,37 +222,30 @@ public:
    * @return true If the piece is a pawn
    * @return false Else
    */
-  virtual bool isPawn() const noexcept;
+  bool isPawn() const noexcept;
 
 
   // #### Setters: ####
 
   /**
-   * @brief Check if the move is legal and execute it
-   *
-   * @param x The new X pos to assign to the chess piece
-   * @param y The new Y pos to assign to the chess piece
-   */
-  virtual void move(const int x, const int y) noexcept;
-
-  /**
-   * @brief Simulate the move to (x, y)
+   * @brief Set the position of the chess piece (the board is updated by Game::makeMove)
    *
    * @param x The new X pos to assign to the chess piece
    * @param y The new Y pos to assign to the chess piece
    */
-  void simulateMove(const int x, const int y) noexcept;
+  void move(const int x, const int y) noexcept;
 
   // #### Methods: ####
 
   /**
    * @brief To get the list of legal moves for the piece
+   * @note Only the moves of this piece are generated (see Game::readMoves)
    *
-   * @throw std::runtime_error Because this method cannot be used on an empty piece
+   * @throw std::runtime_error If the piece is empty (not a Pawn, Knight, ... of a game)
    * 
-   * @return vector<vector<int, int>> The list of pos that the chess piece can hop on
+   * @return MoveList The moves of the chess piece (none if its player does not have to play)
    */
-  virtual vector<vector<int>> read();
+  MoveList read() const;
 
   /**
    * @brief Return if the piece threatens another piece
@@ -204,8 +278,6 @@ protected:
   // #### Attributes: ####
   bool _player = 0;  //< Owner of the chess piece.
   int _x = 0, _y = 0;  //< Position of the piece on the 8*8 board.
-  int _savedIndex = -1; //> Used to identify the saved moves.
-  vector<vector<int>> _savedMoves; //> Used to prevent redondant computing.
-  char _repr = '?';
+  PieceCode _code = NO_PIECE; //< Set by the constructor of each kind of piece
   Game* _game = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+ * @file position.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the Position struct
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <cstdint>
+# include <type_traits>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/bitboard.hpp"
+# include "../header/piece.hpp"
+
+
+/**
+ * @brief The castling rights, as bits of Game::castling
+ *
+ */
+enum CastlingRight
+{
+  WHITE_SHORT = 1,
+  WHITE_LONG = 2,
+  BLACK_SHORT = 4,
+  BLACK_LONG = 8
+};
+
+/**
+ * @brief To get the castling right of a player on a side
+ *
+ * @param player The owner of the king (0: White, 1: Black)
+ * @param kingSide If the castling is short (else long)
+ * @return int
+ */
+constexpr int castlingRight(const bool player, const bool kingSide) noexcept
+{
+  return 1 << ((player << 1) | not kingSide);
+}
+
+
+typedef PieceCode Board[64]; //< The piece on each square, indexed by square (see square in header/bitboard.hpp)
+
+
+/**
+ * @brief A chess position without pointers, that can be copied with memcpy (see Game::position)
+ * @note The pieces are kept as bitboards, so that the rules functions generate from them directly (see header/rules.hpp).
+ * The moves that lead to it are not kept, so the repetitions are only counted from it
+ *
+ */
+struct Position
+{
+  Bitboard players[2]; //< The squares of the pieces of each player
+  Bitboard types[6]; //< The squares of each kind of piece (see PieceType), of both players
+  uint64_t hash; //< The Zobrist key (see Game::hash)
+  uint16_t index; //< The number of moves played since the start of the game (see Game::index)
+  uint16_t fiftyMoves; //< The 50 moves rule counter
+  bool turn; //< The player that is gonna play (0: White, 1: Black)
+  uint8_t castling; //< Bits of CastlingRight
+  int8_t enPassant; //< The square behind a pawn that can be taken en passant (-1 if none)
+};
+
+static_assert(is_trivially_copyable<Position>::value and is_standard_layout<Position>::value, "Position has to stay a POD");
+static_assert(sizeof(Position) <= 128, "Position has to stay compact");
@@ -47,24 +47,8 @@ public:
    */
   Queen(const bool player, const int x, const int y, Game* game);
 
-  // #### Flags: ####
-
-  /**
-   * @brief To get the Queen flag
-   * 
-   * @return true
-   */
-  bool isQueen() const noexcept override;
-
   // #### Methods: ####
 
-  /**
-   * @brief To get the list of legal moves for the queen
-   * 
-   * @return vector<vector<int, int>> The list of pos that the queen can hop on
-   */
-  vector<vector<int>> read() noexcept override;
-
   /**
    * @brief Return if the queen threatens another piece
    * 
@@ -83,17 +67,4 @@ public:
    * @return ostream& The modified stream
    */
   friend ostream& operator<<(ostream& stream, const Queen& me);
-
-private:
-  // #### Auxilary methods: ####
-
-  /**
-   * @brief To check if the case (x, y) is a valid target for the queen
-   * 
-   * @param x The x pos of the target
-   * @param y The y pos of the target
-   * @return true If the queen can continue
-   * @return false If the queen hits a bound (end of grid, other piece, etc.)
-   */
-  bool checkTarget(const int x, const int y) noexcept;
 };
\ No newline at end of file
@@ -44,36 +44,21 @@ public:
    * @param x The X pos of the chess piece
    * @param y The Y pos of the chess piece
    * @param game The game where the chess piece is located
-   * @param didntMove The flag didntMove of the king
    */
-  Rook(const bool player, const int x, const int y, Game* game, bool didntMove = true);
+  Rook(const bool player, const int x, const int y, Game* game);
 
   // #### Flags: ####
 
-  /**
-   * @brief To get the Rook flag
-   * 
-   * @return true
-   */
-  bool isRook() const noexcept override;
-
   /**
    * @brief To get the didntMove flag
    * 
-   * @return true If the rook hasnt moved yet
+   * @return true If the rook hasnt moved yet from its corner (see Game::castling)
    * @return false Else
    */
   bool didntMove() const noexcept;
 
   // #### Methods: ####
 
-  /**
-   * @brief To get the list of legal moves for the rook
-   * 
-   * @return vector<vector<int, int>> The list of pos that the rook can hop on
-   */
-  vector<vector<int>> read() noexcept override;
-
   /**
    * @brief Return if the rook threatens another piece
    * 
@@ -82,14 +67,6 @@ public:
    */
   bool threat(Piece* piece) override;
 
-  /**
-   * @brief Move the rook to (x, y)
-   *
-   * @param x The new X pos to assign to the chess piece
-   * @param y The new Y pos to assign to the chess piece
-   */
-  void move(const int x, const int y) noexcept override;
-
   // #### Operator: ####
 
   /**
@@ -100,20 +77,4 @@ public:
    * @return ostream& The modified stream
    */
   friend ostream& operator<<(ostream& stream, const Rook& me);
-
-private:
-  // #### Attributes: ####
-  bool _didntMove = true;
-
-  // #### Auxilary methods: ####
-
-  /**
-   * @brief To check if the case (x, y) is a valid target for the rook
-   * 
-   * @param x The x pos of the target
-   * @param y The y pos of the target
-   * @return true If the rook can continue
-   * @return false If the rook hits a bound (end of grid, other piece, etc.)
-   */
-  bool checkTarget(const int x, const int y) noexcept;
 };
\ No newline at end of file
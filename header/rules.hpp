@@ -1,7 +1,7 @@
 /**
  * @file rules.hpp
  * @author JakeTheRealOne (jakelevrai@outlook.be)
- * @brief Header file for the GameRules class
+ * @brief Header file for the rules on bitboards (the move generation of Game, and the rules on a Position)
  * @version 0.1
  * @date 29-07-2024
  * 
@@ -10,4 +10,194 @@
  */
 
 
-# pragma once
\ No newline at end of file
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <stdexcept>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/bitboard.hpp"
+# include "../header/move.hpp"
+# include "../header/position.hpp"
+# include "../header/zobrist.hpp"
+
+
+/**
+ * @brief The piece that a pawn becomes, by Move::promotion (PAWN: no promotion)
+ *
+ */
+inline constexpr PieceType PROMOTIONS[5] = {PAWN, QUEEN, ROOK, BISHOP, KNIGHT};
+
+
+/**
+ * @brief To get the castling rights lost when a piece leaves or lands on a square
+ *
+ * @param square The involved square
+ * @return int Bits of CastlingRight
+ */
+int castlingLost(const int square) noexcept;
+
+/**
+ * @brief To get the pieces of a player that attack a square
+ *
+ * @param pieces The squares of each kind of piece, for each player
+ * @param square The attacked square
+ * @param player The owner of the attackers (0: White, 1: Black)
+ * @param occupancy The occupied squares (used to stop the rays of the sliders)
+ * @return Bitboard
+ */
+Bitboard attackersTo(const Bitboard pieces[2][6], const int square, const bool player, const Bitboard occupancy) noexcept;
+
+/**
+ * @brief Append the legal moves of the player to move to a list (the move generation of Game::legalMoves)
+ * @note The checkers and the pinned pieces are computed once for the whole position
+ *
+ * @param pieces The squares of each kind of piece, for each player (each player has one king)
+ * @param occupied The squares occupied by each player
+ * @param player The player to move
+ * @param castling Bits of CastlingRight (each right has its king and rook on their squares)
+ * @param enPassant The en passant square (-1 if none, see enPassantValid)
+ * @param moves The list to fill
+ * @param sources Only the moves of the pieces on these squares are generated (e.g. bit(square) for Piece::read)
+ */
+void generateMoves(const Bitboard pieces[2][6], const Bitboard occupied[2], const bool player, const int castling,
+                   const int enPassant, MoveList& moves, const Bitboard sources = ~Bitboard(0)) noexcept;
+
+/**
+ * @brief To get the number of legal moves of the player to move
+ * @note Same as generateMoves, but the moves are counted from the attack masks without being listed
+ *
+ * @param pieces The squares of each kind of piece, for each player (each player has one king)
+ * @param occupied The squares occupied by each player
+ * @param player The player to move
+ * @param castling Bits of CastlingRight (each right has its king and rook on their squares)
+ * @param enPassant The en passant square (-1 if none, see enPassantValid)
+ * @return int
+ */
+int countMoves(const Bitboard pieces[2][6], const Bitboard occupied[2], const bool player, const int castling,
+               const int enPassant) noexcept;
+
+/**
+ * @brief To know if the en passant square of a position agrees with its pieces
+ * @note The square is behind a pawn of the opponent that was just pushed two rows: it is on the
+ * third row of the opponent, and the square and the origin of the pawn are empty
+ *
+ * @param position The position (its en passant square is not -1)
+ * @return bool
+ */
+bool enPassantValid(const Position& position) noexcept;
+
+/**
+ * @brief To know if a pawn of the player to move can take en passant
+ * @note The en passant square is only kept when it can be taken, so that it only changes the key when it matters
+ *
+ * @param pawns The pawns of the player to move
+ * @param player The player to move
+ * @param enPassant The en passant square (-1 if none)
+ * @return bool
+ */
+bool enPassantCapturable(const Bitboard pawns, const bool player, const int enPassant) noexcept;
+
+/**
+ * @brief Check that a position can be played
+ * @throw std::runtime_error If two pieces share a square, a player does not have one king, has more than 16 pieces
+ * or 8 pawns, a pawn is on the first or last row, a castling right lost its king or rook, or the en passant square is wrong
+ *
+ * @param position The position
+ */
+void checkPosition(const Position& position);
+
+
+/**
+ * @brief To get the legal moves of the player to move
+ * @throw std::runtime_error If the position is invalid (see checkPosition)
+ * @note The moves are generated from the bitboards of the position (no Game is built), so that any thread can call it
+ *
+ * @param position The position
+ * @param moves The list to fill (it is cleared first)
+ */
+void legalMoves(const Position& position, MoveList& moves);
+
+/**
+ * @brief To get the number of legal moves of the player to move
+ * @throw std::runtime_error If the position is invalid (see checkPosition)
+ *
+ * @param position The position
+ * @return int
+ */
+int countLegalMoves(const Position& position);
+
+/**
+ * @brief To get the pieces that are checking the king of the player to move
+ * @throw std::runtime_error If the position is invalid (see checkPosition)
+ *
+ * @param position The position
+ * @return Bitboard
+ */
+Bitboard checkers(const Position& position);
+
+/**
+ * @brief To get the position after a move (its Zobrist key is updated from the one of position)
+ * @throw std::runtime_error If the position is invalid (see checkPosition), or if the move does not start
+ * on a piece of the player to move
+ *
+ * @param position The position
+ * @param move A legal move of the position (see legalMoves)
+ * @return Position
+ */
+Position play(const Position& position, const Move move);
+
+
+/**
+ * @brief Apply a move to a board and update its state: the rules of a move, shared by play and Game::makeMove
+ * @throw std::runtime_error If the move castles without a rook
+ *
+ * @param board The board, with the state of a Position (hash, castling, enPassant, fiftyMoves, turn, index),
+ * typeAt(square) (-1 if empty), pieces(player, type), and lift, place and relocate that update the piece keys
+ * @param move A legal move of the board
+ * @return int The PieceType of the captured piece (-1 if none)
+ */
+template <class Mover>
+int applyMove(Mover& board, const Move move)
+{
+  const bool player = board.turn;
+  const int from = move.from(), to = move.to(), fromX = squareX(from), fromY = squareY(from), x = move.x();
+  const int type = board.typeAt(from);
+  // En passant eats the pawn beside
+  const int eaten = move.flag() == Move::EN_PASSANT ? square(x, fromY) : to;
+  const int captured = board.typeAt(eaten);
+  if (captured >= 0)
+  {
+    board.lift(not player, captured, eaten);
+  }
+  if (move.flag() == Move::CASTLING)
+  {
+    int rook = square(x < fromX ? 0 : 7, fromY);
+    if (not (board.pieces(player, ROOK) & bit(rook)))
+    {
+      throw runtime_error("try to castle but no rook was detected");
+    }
+    board.relocate(player, ROOK, rook, square((fromX + x) >> 1, fromY));
+  }
+  board.relocate(player, type, from, to);
+  if (move.promotion())
+  {
+    board.lift(player, PAWN, to);
+    board.place(player, PROMOTIONS[move.promotion()], to);
+  }
+  // Update the state that cannot be read from the pieces
+  board.hash ^= stateKey(board.castling, board.enPassant, board.turn);
+  board.enPassant = -1;
+  if (move.flag() == Move::DOUBLE_PUSH and enPassantCapturable(board.pieces(not player, PAWN), not player, (from + to) >> 1))
+  {
+    board.enPassant = (from + to) >> 1;
+  }
+  board.castling &= ~(castlingLost(from) | castlingLost(to));
+  board.fiftyMoves = (type == PAWN or captured >= 0) ? 0 : board.fiftyMoves + 1;
+  board.turn = not player;
+  ++ board.index;
+  board.hash ^= stateKey(board.castling, board.enPassant, board.turn);
+  return captured;
+}
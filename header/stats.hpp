@@ -0,0 +1,65 @@
+/**
+ * @file stats.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the counters of the move generation (see the --stats flag)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <cstdint>
+# include <iostream>
+using namespace std;
+
+
+/**
+ * @brief The events that are counted
+ *
+ */
+enum Stat
+{
+  READS, //< Calls of Piece::read
+  CACHE_LOOKUPS, //< Positions looked for in the MoveCache
+  CACHE_HITS, //< Positions found in the MoveCache
+  KING_TESTS, //< King targets tested for an attack (the simulateMove round trips of the former filterKingMoves)
+  EN_PASSANT_CHECKS, //< En passant moves tested for a check along the row
+  MOVES, //< Calls of Game::move
+  MAKE_MOVES, //< Calls of Game::makeMove
+  UNMAKE_MOVES, //< Calls of Game::unmakeMove
+  LEGAL_MOVES, //< Calls of Game::legalMoves
+  COUNT_LEGAL_MOVES, //< Calls of Game::countLegalMoves
+  STATS //< The number of events
+};
+
+
+# ifdef CHESS_STATS
+extern thread_local uint64_t threadStats[STATS]; //< The counters of the thread (trivial, so no TLS wrapper call)
+# define COUNT_STAT(stat) (++ threadStats[stat])
+# define ADD_STAT(stat, count) (threadStats[stat] += (count))
+# else //< Compiled out: the counted code is the same as without the counters
+# define COUNT_STAT(stat) ((void)0)
+# define ADD_STAT(stat, count) ((void)(count))
+# endif
+
+
+/**
+ * @brief Add the counters of the current thread to the totals, and reset them
+ * @note Has to be called by every thread that counts, before it ends (see ThreadPool::work)
+ *
+ */
+void flushStats() noexcept;
+
+/**
+ * @brief Print the totals of the counters (the current thread is flushed first), and their rate per played move
+ * @note Without CHESS_STATS (make STATS=1), only says that the counters are compiled out
+ *
+ * @param stream The output
+ */
+void printStats(ostream& stream);
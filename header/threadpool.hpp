@@ -0,0 +1,125 @@
+/**
+ * @file threadpool.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the ThreadPool class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <atomic>
+# include <condition_variable>
+# include <deque>
+# include <functional>
+# include <memory>
+# include <mutex>
+# include <thread>
+# include <vector>
+using namespace std;
+
+
+/**
+ * @brief The ThreadPool class runs tasks on a fixed set of threads
+ * @note Each thread owns a queue: it takes its own tasks from the back and,
+ * once its queue is empty, steals the oldest tasks of the other threads
+ *
+ */
+class ThreadPool
+{
+public:
+  /**
+   * @brief A task, that receives the index of the thread that runs it (from 0 to size - 1)
+   *
+   */
+  typedef function<void(const int worker)> Task;
+
+  // #### Constructors: ####
+
+  /**
+   * @brief Construct a new ThreadPool object and start its threads
+   *
+   * @param size The number of threads (0: one per core)
+   */
+  ThreadPool(const int size = 0);
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // #### Destructor: ####
+
+  /**
+   * @brief Destroy the ThreadPool object (wait for the tasks, then join the threads)
+   *
+   */
+  ~ThreadPool();
+
+  // #### Getters: ####
+
+  /**
+   * @brief To get the number of threads
+   *
+   * @return int
+   */
+  int size() const noexcept;
+
+  // #### Methods: ####
+
+  /**
+   * @brief Add a task to the queues (round robin between the threads)
+   *
+   * @param task The task to run
+   */
+  void submit(Task task);
+
+  /**
+   * @brief Block until every submitted task is done
+   *
+   */
+  void wait();
+
+private:
+  /**
+   * @brief The queue of a thread
+   *
+   */
+  struct Queue
+  {
+    mutex lock;
+    deque<Task> tasks;
+  };
+
+  // #### Attributes: ####
+  vector<unique_ptr<Queue>> _queues;
+  vector<thread> _workers;
+  mutex _lock; //< Protects the sleep of the threads and of wait
+  condition_variable _wake, _done;
+  int _queued = 0; //< The tasks that are waiting in a queue (protected by _lock)
+  int _pending = 0; //< The tasks that are not done yet (protected by _lock)
+  unsigned _next = 0; //< The queue of the next submitted task
+  bool _stop = false;
+
+  // #### Auxiliary methods: ####
+
+  /**
+   * @brief The loop of a thread
+   *
+   * @param index The index of the thread
+   */
+  void work(const int index);
+
+  /**
+   * @brief Take a task, from the queue of the thread first, then from the other queues
+   *
+   * @param index The index of the thread
+   * @param task The taken task
+   * @return bool If a task was found
+   */
+  bool take(const int index, Task& task);
+};
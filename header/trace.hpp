@@ -0,0 +1,76 @@
+/**
+ * @file trace.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the scoped tracing (see the --trace flag)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <cstdint>
+# include <string>
+using namespace std;
+
+
+/**
+ * @brief The TraceScope class records the time spent in a scope (RAII), while the tracing is on
+ * @note The events go to a ring buffer of the thread (the oldest ones are overwritten), so a scope
+ * only costs two clock reads. While the tracing is off, it only costs a test
+ *
+ */
+class TraceScope
+{
+public:
+  // #### Constructors: ####
+
+  /**
+   * @brief Start a scope
+   *
+   * @param name The name of the scope (a string literal: it is not copied)
+   */
+  explicit TraceScope(const char* name) noexcept;
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+  // #### Destructor: ####
+
+  /**
+   * @brief End the scope and record it
+   *
+   */
+  ~TraceScope() noexcept;
+
+private:
+  // #### Attributes: ####
+  const char* _name;
+  int64_t _start = -1; //< -1 if the tracing was off
+};
+
+
+# define TRACE_JOIN(a, b) a##b
+# define TRACE_NAME(line) TRACE_JOIN(traceScope, line)
+# define TRACE_SCOPE(name) TraceScope TRACE_NAME(__LINE__)(name) //< Trace the rest of the current scope
+
+
+/**
+ * @brief Turn the tracing on (it is off by default)
+ *
+ */
+void startTracing() noexcept;
+
+/**
+ * @brief Write the recorded scopes of every thread in the Chrome trace event format
+ * @note The file can be opened with chrome://tracing or https://ui.perfetto.dev
+ * @throw std::runtime_error If the file cannot be written
+ *
+ * @param path The path of the JSON file
+ */
+void writeTrace(const string& path);
@@ -0,0 +1,96 @@
+/**
+ * @file zobrist.hpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Header file for the Zobrist keys
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+# pragma once
+
+
+// #### Std inclusions: ####
+# include <cstdint>
+using namespace std;
+
+
+/**
+ * @brief The random keys that are XORed together to hash a position
+ * @note A position key is the XOR of the keys of its pieces, castling rights,
+ * en passant file and side to move, so a move only updates a few of them
+ *
+ */
+struct ZobristKeys
+{
+  uint64_t pieces[2][6][64] = {}; //< For each player, kind of piece (see PieceType) and square
+  uint64_t castling[16] = {}; //< For each set of castling rights (see CastlingRight)
+  uint64_t enPassant[8] = {}; //< For each file of the en passant square
+  uint64_t side = 0; //< Present when Black has to play
+};
+
+
+/**
+ * @brief The next number of a SplitMix64 generator
+ *
+ * @param state The state of the generator
+ * @return uint64_t
+ */
+constexpr uint64_t splitMix64(uint64_t& state) noexcept
+{
+  uint64_t output = (state += 0x9e3779b97f4a7c15ULL);
+  output = (output ^ (output >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  output = (output ^ (output >> 27)) * 0x94d049bb133111ebULL;
+  return output ^ (output >> 31);
+}
+
+
+/**
+ * @brief Build the Zobrist keys from a seed
+ *
+ * @param seed The seed of the generator
+ * @return ZobristKeys
+ */
+constexpr ZobristKeys zobristKeys(uint64_t seed) noexcept
+{
+  ZobristKeys output;
+  for (int player = 0; player < 2; ++ player)
+  {
+    for (int type = 0; type < 6; ++ type)
+    {
+      for (int square = 0; square < 64; ++ square)
+      {
+        output.pieces[player][type][square] = splitMix64(seed);
+      }
+    }
+  }
+  for (uint64_t& key : output.castling)
+  {
+    key = splitMix64(seed);
+  }
+  for (uint64_t& key : output.enPassant)
+  {
+    key = splitMix64(seed);
+  }
+  output.side = splitMix64(seed);
+  return output;
+}
+
+inline constexpr ZobristKeys ZOBRIST = zobristKeys(0x43484553534a4b4cULL); //< "CHESSJKL"
+
+
+/**
+ * @brief To get the part of a Zobrist key that does not come from the pieces
+ *
+ * @param castling Bits of CastlingRight
+ * @param enPassant The en passant square (-1 if none)
+ * @param turn The player to move
+ * @return uint64_t The keys of the castling rights, en passant file and side to move
+ */
+inline uint64_t stateKey(const int castling, const int enPassant, const bool turn) noexcept
+{
+  return ZOBRIST.castling[castling] ^ (enPassant >= 0 ? ZOBRIST.enPassant[enPassant & 7] : 0) ^ (turn ? ZOBRIST.side : 0);
+}
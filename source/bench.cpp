@@ -0,0 +1,166 @@
+/**
+ * @file bench.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the bench command (fixed workload of the rules)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <algorithm>
+# include <chrono>
+# include <cstdint>
+# include <iostream>
+# include <iterator>
+# include <string>
+# include <vector>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/bench.hpp"
+# include "../header/game.hpp"
+
+
+namespace
+{
+  /**
+   * @brief The starting positions of the games
+   *
+   */
+  const char* POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
+  };
+
+  const int GAMES = 160; //< The games played from each position
+  const int PLIES = 500; //< The length of a game that does not end before
+
+
+  /**
+   * @brief The totals of the workload
+   *
+   */
+  struct Totals
+  {
+    long nodes = 0; //< The moves returned by Piece::read
+    long plies = 0; //< The moves played with Game::move
+    long mates = 0, stalemates = 0, draws = 0, unfinished = 0;
+    size_t memory = 0; //< The sum of Game::memoryUsage at the end of the games
+  };
+
+
+  /**
+   * @brief The next number of a xorshift generator (the same on every platform)
+   *
+   * @param state The state of the generator (not 0)
+   * @return uint64_t
+   */
+  uint64_t xorshift(uint64_t& state) noexcept
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+
+  /**
+   * @brief Play a game like run does: read the moves of the pieces of the player, then play one of them
+   * @note The moves are sorted before one is drawn, so that the game does not depend on the
+   * order in which the pieces generate their moves
+   *
+   * @param game The game, at its starting position
+   * @param seed The seed of the moves that are drawn
+   * @param totals The totals to update
+   */
+  void play(Game& game, uint64_t seed, Totals& totals)
+  {
+    vector<int> moves; //< Packed as (from << 6 | to) << 3 | promotion
+    bool isOver = game.isMate();
+    for (int ply = 0; ply < PLIES and not isOver; ++ ply)
+    {
+      moves.clear();
+      for (int y = 0; y < game.SIZE; ++ y)
+      {
+        for (int x = 0; x < game.SIZE; ++ x)
+        {
+          Piece* piece = game.at(x, y);
+          if (piece == nullptr or piece->player() != game.turn())
+          {
+            continue;
+          }
+          const MoveList list = piece->read();
+          totals.nodes += list.size();
+          for (const Move move : list)
+          {
+            moves.push_back(((move.from() << 6 | move.to()) << 3) | move.promotion());
+          }
+        }
+      }
+      sort(moves.begin(), moves.end());
+      int move = moves[xorshift(seed) % moves.size()];
+      int from = move >> 9, to = (move >> 3) & 0x3f;
+      game.move(game.at(squareX(from), squareY(from)), squareX(to), squareY(to), move & 7);
+      ++ totals.plies;
+      isOver = game.isMate();
+    }
+    if (not isOver)
+    {
+      ++ totals.unfinished;
+    }
+    else if (game.drawBy50Moves() or game.drawByRepetition())
+    {
+      ++ totals.draws;
+    }
+    else if (not game.checkList().empty())
+    {
+      ++ totals.mates;
+    }
+    else
+    {
+      ++ totals.stalemates;
+    }
+  }
+}
+
+
+int benchCommand(const int argc, char** argv)
+{
+  if (argc)
+  {
+    cerr << "unknown argument: " << argv[0] << "\nusage: chess bench" << endl;
+    return 1;
+  }
+  Totals totals;
+  auto start = chrono::steady_clock::now();
+  for (const char* fen : POSITIONS)
+  {
+    for (int index = 0; index < GAMES; ++ index)
+    {
+      Game game;
+      game.setFen(fen);
+      play(game, 0x9e3779b97f4a7c15ULL * (index + 1), totals);
+      totals.memory += game.memoryUsage();
+    }
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  cout << "Games: " << size(POSITIONS) * GAMES
+       << " (" << totals.mates << " checkmates, " << totals.stalemates << " stalemates, "
+       << totals.draws << " draws, " << totals.unfinished << " unfinished)\n"
+       << "Plies: " << totals.plies << '\n'
+       << "Memory: " << totals.memory / (size(POSITIONS) * GAMES) << " bytes per game (sizeof(Game): " << sizeof(Game) << ")\n"
+       << "Signature: " << totals.nodes << '\n'
+       << "Time: " << long(seconds * 1000) << " ms\n"
+       << "Nodes/second: " << long(totals.nodes / max(seconds, 1e-9)) << '\n'
+       << "Plies/second: " << long(totals.plies / max(seconds, 1e-9)) << endl;
+  return 0;
+}
@@ -24,91 +24,20 @@ using namespace std;
 Bishop::Bishop():
 Piece()
 {
-  _repr = 'B';
+  _code = pieceCode(_player, BISHOP);
 }
 
 
 Bishop::Bishop(const bool player, const int x, const int y, Game* game):
 Piece(player, x, y, game)
 {
-  _repr = 'B';
+  _code = pieceCode(_player, BISHOP);
 }
 
 
-bool Bishop::isBishop() const noexcept
+bool Bishop::threat(Piece* piece)
 {
-  return true;
-}
-
-
-vector<vector<int>> Bishop::read() noexcept
-{
-  /*
-    X   X
-     X X
-      B
-     X X
-    X   X
-  */
-  if (_game->index() == _savedIndex)
-  {
-    return _savedMoves;
-  }
-  _savedMoves.clear();
-  _savedIndex = _game->index();
-
-  int size = _game->SIZE, i, j, increI, increJ;
-  for (int a = 0; a < 4; ++ a)
-  {
-    increI = a >> 1 ? 1 : -1;
-    increJ = a & 1 ? 1 : -1;
-    i = _x + increI;
-    j = _y + increJ;
-    while (i >= 0 and i < size and j >= 0 and j < size)
-    {
-      if (not checkTarget(i, j))
-      {
-        break;
-      }
-      i += increI;
-      j += increJ;
-    }
-  }
-  _game->filterMoves(this, _savedMoves);
-  return _savedMoves;
-}
-
-
-bool Bishop::threat(Piece* piece){
-  if (_x - _y == piece->x() - piece->y())
-  { // Diag A
-    int increment = _x < piece->x() ? +1 : -1;
-    int currentX = _x + increment, currentY = _y + increment;
-    while (currentX != piece->x())
-    {
-      if (_game->at(currentX, currentY) != nullptr)
-      {
-        return false;
-      }
-      currentX += increment, currentY += increment;
-    }
-    return true;
-  }
-  else if (_x + _y == piece->x() + piece->y())
-  { // Diag B
-    int increment = _x < piece->x() ? +1 : -1;
-    int currentX = _x + increment, currentY = _y - increment;
-    while (currentX != piece->x())
-    {
-      if (_game->at(currentX, currentY) != nullptr)
-      {
-        return false;
-      }
-      currentX += increment, currentY -= increment;
-    }
-    return true;
-  }
-  return false;
+  return bishopAttacks(square(_x, _y), _game->occupied()) & bit(square(piece->x(), piece->y()));
 }
 
 
@@ -118,19 +47,3 @@ ostream& operator<<(ostream& stream, const Bishop& me)
          << ", " << me._x << ", " << me._y << ")";
   return stream;
 }
-
-
-bool Bishop::checkTarget(const int x, const int y) noexcept
-{
-    Piece* target = _game->at(x, y);
-    if (target == nullptr)
-    {
-      _savedMoves.push_back({x, y});
-      return true;
-    }
-    else if (target->player() != _player)
-    {
-      _savedMoves.push_back({x, y});
-    }
-    return false;
-}
\ No newline at end of file
@@ -0,0 +1,388 @@
+/**
+ * @file check.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the check command (self checks of the game state, run by make check)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <cstdint>
+# include <exception>
+# include <filesystem>
+# include <iostream>
+# include <string>
+# include <vector>
+using namespace std;
+namespace fs = filesystem;
+
+// #### Internal inclusions: ####
+# include "../header/check.hpp"
+# include "../header/game.hpp"
+# include "../header/rules.hpp"
+# include "../header/zobrist.hpp"
+
+
+namespace
+{
+  /**
+   * @brief The starting positions of the random games (the positions of make check)
+   *
+   */
+  const char* POSITIONS[] = {
+    "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"
+  };
+
+  const int GAMES = 20; //< The random games played from each position
+  const int PLIES = 200; //< The length of a random game that does not end before
+  const int SAVES = 40; //< The random games that are saved and loaded back
+  const int SAVE_PLIES = 60; //< The longest of them (the save file keeps the index of the move on a char)
+
+
+  /**
+   * @brief The next number of a xorshift generator (the same on every platform)
+   *
+   * @param state The state of the generator (not 0)
+   * @return uint64_t
+   */
+  uint64_t xorshift(uint64_t& state) noexcept
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+
+
+  /**
+   * @brief To know if two positions are the same, state and key included
+   *
+   * @param first The first position
+   * @param second The second position
+   * @return bool
+   */
+  bool same(const Position& first, const Position& second) noexcept
+  {
+    for (int player = 0; player < 2; ++ player)
+    {
+      if (first.players[player] != second.players[player])
+      {
+        return false;
+      }
+    }
+    for (int type = PAWN; type <= KING; ++ type)
+    {
+      if (first.types[type] != second.types[type])
+      {
+        return false;
+      }
+    }
+    return first.hash == second.hash and first.index == second.index and first.fiftyMoves == second.fiftyMoves
+       and first.turn == second.turn and first.castling == second.castling and first.enPassant == second.enPassant;
+  }
+
+
+  /**
+   * @brief To get the Zobrist key of a position from its pieces and state, without the incremental updates
+   *
+   * @param position The position
+   * @return uint64_t
+   */
+  uint64_t freshKey(const Position& position) noexcept
+  {
+    uint64_t output = stateKey(position.castling, position.enPassant, position.turn);
+    for (int player = 0; player < 2; ++ player)
+    {
+      for (int type = PAWN; type <= KING; ++ type)
+      {
+        Bitboard pieces = position.players[player] & position.types[type];
+        while (pieces)
+        {
+          output ^= ZOBRIST.pieces[player][type][popLsb(pieces)];
+        }
+      }
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief Play a legal move given in coordinate notation
+   *
+   * @param game The game
+   * @param move The move (e.g. g1f3, see Move::str)
+   * @return bool false if it is not legal
+   */
+  bool playMove(Game& game, const string& move)
+  {
+    MoveList moves;
+    game.legalMoves(moves);
+    for (const Move legal : moves)
+    {
+      if (legal.str() == move)
+      {
+        game.makeMove(legal);
+        return true;
+      }
+    }
+    return false;
+  }
+
+
+  /**
+   * @brief Play random games and take back every move, the Position has to come back exactly
+   * @note Each move is also played on the Position with play, that has to give the same Position as makeMove
+   *
+   * @return string The failure ("" if none)
+   */
+  string checkUnmake()
+  {
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    MoveList moves;
+    vector<Position> past;
+    for (const char* fen : POSITIONS)
+    {
+      for (int index = 0; index < GAMES; ++ index)
+      {
+        Game game;
+        game.setFen(fen);
+        past.clear();
+        for (int ply = 0; ply < PLIES; ++ ply)
+        {
+          game.legalMoves(moves);
+          if (moves.empty())
+          {
+            break;
+          }
+          const Position before = game.position();
+          const Move move = moves[xorshift(seed) % moves.size()];
+          game.makeMove(move);
+          if (not same(game.position(), play(before, move)))
+          {
+            return "play and makeMove disagree on " + move.str() + " in " + Game(before).fen();
+          }
+          game.unmakeMove();
+          if (not same(game.position(), before))
+          {
+            return "unmakeMove of " + move.str() + " gives " + game.fen() + " instead of " + Game(before).fen();
+          }
+          game.makeMove(move);
+          past.push_back(before);
+        }
+        while (not past.empty())
+        {
+          game.unmakeMove();
+          if (not same(game.position(), past.back()))
+          {
+            return "taking back the game gives " + game.fen() + " instead of " + Game(past.back()).fen();
+          }
+          past.pop_back();
+        }
+      }
+    }
+    return "";
+  }
+
+
+  /**
+   * @brief Play random games and compare the incremental key with the key computed from scratch after each move
+   *
+   * @return string The failure ("" if none)
+   */
+  string checkKeys()
+  {
+    uint64_t seed = 0x2545f4914f6cdd1dULL;
+    MoveList moves;
+    for (const char* fen : POSITIONS)
+    {
+      for (int index = 0; index < GAMES; ++ index)
+      {
+        Game game;
+        game.setFen(fen);
+        for (int ply = 0; ply < PLIES; ++ ply)
+        {
+          game.legalMoves(moves);
+          if (moves.empty())
+          {
+            break;
+          }
+          const Move move = moves[xorshift(seed) % moves.size()];
+          game.makeMove(move);
+          if (game.hash() != freshKey(game.position()))
+          {
+            return "wrong key after " + move.str() + " in " + game.fen();
+          }
+        }
+      }
+    }
+    return "";
+  }
+
+
+  /**
+   * @brief Shuffle the knights back and forth, the third occurrence of a position is a draw and not the second
+   *
+   * @return string The failure ("" if none)
+   */
+  string checkRepetition()
+  {
+    const string shuffle[4] = {"g1f3", "g8f6", "f3g1", "f6g8"};
+    Game game;
+    for (const string move : {"e2e4", "e7e5"}) //< The repetitions are only counted since the last pawn move
+    {
+      playMove(game, move);
+    }
+    for (int ply = 0; ply < 8; ++ ply)
+    {
+      if (game.drawByRepetition())
+      {
+        return "draw after " + to_string(ply) + " plies of shuffle";
+      }
+      if (not playMove(game, shuffle[ply & 3]))
+      {
+        return shuffle[ply & 3] + " is not legal in " + game.fen();
+      }
+    }
+    if (not game.drawByRepetition())
+    {
+      return "no draw after the third occurrence of " + game.fen();
+    }
+    game.unmakeMove();
+    if (game.drawByRepetition())
+    {
+      return "still a draw after taking back the last move";
+    }
+    return "";
+  }
+
+
+  /**
+   * @brief Play around the limit of the 50 moves rule (50 plies without a pawn move or a capture, see drawBy50Moves)
+   *
+   * @return string The failure ("" if none)
+   */
+  string checkFiftyMoves()
+  {
+    Game game;
+    game.setFen("7k/8/8/8/8/8/P7/K7 w - - 49 40");
+    if (game.drawBy50Moves())
+    {
+      return "draw after 49 plies";
+    }
+    playMove(game, "a1b1");
+    if (not game.drawBy50Moves())
+    {
+      return "no draw after 50 plies";
+    }
+    game.unmakeMove();
+    playMove(game, "a2a3");
+    if (game.drawBy50Moves())
+    {
+      return "the pawn move did not reset the counter";
+    }
+    game.setFen("7k/8/8/8/8/8/1p6/K7 w - - 49 40");
+    playMove(game, "a1b2");
+    if (game.drawBy50Moves())
+    {
+      return "the capture did not reset the counter";
+    }
+    return "";
+  }
+
+
+  /**
+   * @brief Save random games and load them back, the loaded game has to be at the same Position
+   *
+   * @return string The failure ("" if none)
+   */
+  string checkSaves()
+  {
+    uint64_t seed = 0xd1b54a32d192ed03ULL;
+    string name = "check", path = "memory/saved_games/" + name;
+    bool created = fs::create_directories("memory/saved_games");
+    string failure;
+    MoveList moves;
+    for (int index = 0; index < SAVES and failure.empty(); ++ index)
+    {
+      Game game;
+      game.setName(name);
+      const int plies = xorshift(seed) % SAVE_PLIES;
+      for (int ply = 0; ply < plies; ++ ply)
+      {
+        game.legalMoves(moves);
+        if (moves.empty())
+        {
+          break;
+        }
+        game.makeMove(moves[xorshift(seed) % moves.size()]);
+      }
+      game.save();
+      Game loaded(path);
+      if (not same(loaded.position(), game.position()))
+      {
+        failure = game.fen() + " is loaded as " + loaded.fen();
+      }
+    }
+    fs::remove(path);
+    if (created)
+    {
+      fs::remove("memory/saved_games");
+    }
+    return failure;
+  }
+
+
+  /**
+   * @brief Run a check and print its result (in the format of make check)
+   *
+   * @param name The name of the check
+   * @param check The check
+   * @return bool true if it passed
+   */
+  bool report(const string& name, string (*check)())
+  {
+    string failure;
+    try
+    {
+      failure = check();
+    }
+    catch (const exception& error)
+    {
+      failure = error.what();
+    }
+    if (failure.empty())
+    {
+      cout << "ok     " << name << endl;
+    }
+    else
+    {
+      cout << "FAILED " << name << ": " << failure << endl;
+    }
+    return failure.empty();
+  }
+}
+
+
+int checkCommand(const int argc, char** argv)
+{
+  if (argc)
+  {
+    cerr << "unknown argument: " << argv[0] << "\nusage: chess check" << endl;
+    return 1;
+  }
+  bool passed = report("unmakeMove restores the position", checkUnmake);
+  passed = report("incremental key equals the key from scratch", checkKeys) and passed;
+  passed = report("draw by threefold repetition", checkRepetition) and passed;
+  passed = report("draw by the 50 moves rule", checkFiftyMoves) and passed;
+  passed = report("save and load round trip", checkSaves) and passed;
+  return not passed;
+}
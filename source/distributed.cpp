@@ -0,0 +1,540 @@
+/**
+ * @file distributed.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the distributed perft (coordinator and workers)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <cerrno>
+# include <chrono>
+# include <condition_variable>
+# include <cstring>
+# include <deque>
+# include <fstream>
+# include <iostream>
+# include <map>
+# include <memory>
+# include <mutex>
+# include <new>
+# include <sstream>
+# include <stdexcept>
+# include <string>
+# include <thread>
+# include <vector>
+using namespace std;
+
+// #### Posix inclusions: ####
+# include <netdb.h>
+# include <poll.h>
+# include <sys/socket.h>
+# include <sys/un.h>
+# include <unistd.h>
+
+// #### Internal inclusions: ####
+# include "../header/distributed.hpp"
+# include "../header/perft.hpp"
+
+
+namespace
+{
+  const chrono::seconds HEARTBEAT(5); //< A worker says it is alive this often, even in the middle of a job
+  const chrono::seconds TIMEOUT(30); //< A worker that said nothing for this long is dead (power loss, network split)
+  const int ATTEMPTS = 3; //< The workers that a job can lose before the run stops
+
+
+  /**
+   * @brief Open a socket that listens on (server) or is connected to (client) an address
+   * @throw std::runtime_error If the socket cannot be opened
+   *
+   * @param address "unix:<path>" or "<host>:<port>" (no host: the loopback, "*": every interface of a server)
+   * @param server If the socket listens (else it connects)
+   * @return int The file descriptor of the socket
+   */
+  int openSocket(const string& address, const bool server)
+  {
+    int descriptor = -1;
+    if (address.rfind("unix:", 0) == 0)
+    {
+      sockaddr_un local = {};
+      local.sun_family = AF_UNIX;
+      string path = address.substr(5);
+      if (path.empty() or path.size() >= sizeof(local.sun_path))
+      {
+        throw runtime_error("invalid socket path: " + path);
+      }
+      strcpy(local.sun_path, path.c_str());
+      descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+      if (server)
+      {
+        unlink(path.c_str()); //< Left by a previous coordinator
+      }
+      if (descriptor < 0 or (server ? bind(descriptor, (sockaddr*)&local, sizeof(local)) or listen(descriptor, 64)
+                                    : connect(descriptor, (sockaddr*)&local, sizeof(local))))
+      {
+        int error = errno;
+        close(descriptor);
+        throw runtime_error(address + ": " + strerror(error));
+      }
+      return descriptor;
+    }
+
+    size_t colon = address.rfind(':');
+    if (colon == string::npos)
+    {
+      throw runtime_error("invalid address (unix:<path> or <host>:<port>): " + address);
+    }
+    string host = address.substr(0, colon), port = address.substr(colon + 1);
+    if (server and host.empty())
+    {
+      host = "127.0.0.1"; //< Every interface only on request ("*"): the workers are trusted with the run
+    }
+    bool everywhere = server and host == "*";
+    addrinfo hints = {}, * found = nullptr;
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = everywhere ? AI_PASSIVE : 0;
+    int status = getaddrinfo(host.empty() or everywhere ? nullptr : host.c_str(), port.c_str(), &hints, &found);
+    if (status)
+    {
+      throw runtime_error(address + ": " + gai_strerror(status));
+    }
+    string error = "no usable address";
+    for (addrinfo* candidate = found; candidate != nullptr; candidate = candidate->ai_next)
+    {
+      descriptor = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+      int reuse = 1;
+      if (descriptor >= 0 and (server ? setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse))
+                                        or bind(descriptor, candidate->ai_addr, candidate->ai_addrlen) or listen(descriptor, 64)
+                                      : connect(descriptor, candidate->ai_addr, candidate->ai_addrlen)) == 0)
+      {
+        freeaddrinfo(found);
+        return descriptor;
+      }
+      error = strerror(errno);
+      if (descriptor >= 0)
+      {
+        close(descriptor);
+      }
+    }
+    freeaddrinfo(found);
+    throw runtime_error(address + ": " + error);
+  }
+
+
+  /**
+   * @brief Send a whole line on a socket
+   *
+   * @param descriptor The socket
+   * @param line The line (without its end)
+   * @return bool If the line was sent (false if the other side is gone)
+   */
+  bool sendLine(const int descriptor, const string& line) noexcept
+  {
+    string data = line + '\n';
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+      ssize_t count = send(descriptor, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if (count <= 0)
+      {
+        return false;
+      }
+      sent += count;
+    }
+    return true;
+  }
+
+
+  /**
+   * @brief Receive what is available on a socket and extract the complete lines
+   *
+   * @param descriptor The socket
+   * @param buffer The data received before (an incomplete line)
+   * @param lines The complete lines (appended)
+   * @return bool If the socket is still open
+   */
+  bool receiveLines(const int descriptor, string& buffer, vector<string>& lines)
+  {
+    char data[4096];
+    ssize_t count = recv(descriptor, data, sizeof(data), 0);
+    if (count <= 0)
+    {
+      return false;
+    }
+    buffer.append(data, count);
+    size_t end;
+    while ((end = buffer.find('\n')) != string::npos)
+    {
+      lines.push_back(buffer.substr(0, end));
+      buffer.erase(0, end + 1);
+    }
+    return true;
+  }
+
+
+  /**
+   * @brief A worker seen by the coordinator
+   *
+   */
+  struct Worker
+  {
+    string buffer; //< The incomplete line received
+    int job = -1; //< The job being explored (-1 if none)
+    chrono::steady_clock::time_point deadline; //< When the worker is dead if it says nothing (see TIMEOUT)
+  };
+}
+
+
+vector<long> coordinate(Game& game, const int depth, const string& address, const string& checkpoint, const int jobs)
+{
+  MoveList moves;
+  game.legalMoves(moves);
+  vector<long> output(moves.size(), depth == 1);
+  if (depth <= 1)
+  {
+    return output;
+  }
+
+  // The jobs: the position of each subtree and its remaining depth
+  vector<Subtree> subtrees = split(game, depth, jobs);
+  vector<string> positions;
+  for (const Subtree& subtree : subtrees)
+  {
+    for (const Move move : subtree.path)
+    {
+      game.makeMove(move);
+    }
+    positions.push_back(to_string(depth - subtree.path.size()) + ' ' + game.fen());
+    for (size_t index = 0; index < subtree.path.size(); ++ index)
+    {
+      game.unmakeMove();
+    }
+  }
+  vector<long> nodes(subtrees.size(), -1);
+  size_t done = 0;
+
+  // Resume from the checkpoint
+  string header = "perft " + to_string(depth) + ' ' + to_string(subtrees.size()) + ' ' + game.fen();
+  unique_ptr<ofstream> log;
+  if (not checkpoint.empty())
+  {
+    ifstream previous(checkpoint);
+    string line;
+    if (previous and getline(previous, line))
+    {
+      if (line != header)
+      {
+        throw runtime_error("the checkpoint " + checkpoint + " belongs to another perft (" + line + ")");
+      }
+      long id, count;
+      while (previous >> id >> count)
+      {
+        if (id >= 0 and size_t(id) < nodes.size() and nodes[id] < 0)
+        {
+          nodes[id] = count;
+          ++ done;
+        }
+      }
+      log = make_unique<ofstream>(checkpoint, ios::app);
+      cerr << "resumed " << done << "/" << nodes.size() << " jobs from " << checkpoint << endl;
+    }
+    else
+    {
+      log = make_unique<ofstream>(checkpoint);
+      *log << header << endl;
+    }
+    if (not *log)
+    {
+      throw runtime_error("cannot write the checkpoint " + checkpoint);
+    }
+  }
+  deque<int> pending;
+  for (size_t id = 0; id < nodes.size(); ++ id)
+  {
+    if (nodes[id] < 0)
+    {
+      pending.push_back(id);
+    }
+  }
+
+  // Hand out the jobs until they are all done
+  using Clock = chrono::steady_clock;
+  int listener = openSocket(address, true);
+  map<int, Worker> workers;
+  vector<int> attempts(nodes.size(), 0); //< The workers lost by each job
+  auto assign = [&](const int descriptor, Worker& worker)
+  {
+    if (worker.job < 0 and not pending.empty())
+    {
+      worker.job = pending.front();
+      pending.pop_front();
+      sendLine(descriptor, "JOB " + to_string(worker.job) + ' ' + positions[worker.job]); //< A failure shows up in poll
+    }
+  };
+  auto drop = [&](const int descriptor, const char* reason)
+  {
+    Worker& worker = workers[descriptor];
+    if (worker.job >= 0 and nodes[worker.job] < 0)
+    {
+      if (++ attempts[worker.job] >= ATTEMPTS)
+      {
+        throw runtime_error("job " + to_string(worker.job) + " lost " + to_string(ATTEMPTS) + " workers, the run stops ("
+                            + positions[worker.job] + ")");
+      }
+      cerr << "worker " << descriptor << ' ' << reason << ", job " << worker.job << " handed out again" << endl;
+      pending.push_front(worker.job);
+    }
+    close(descriptor);
+    workers.erase(descriptor);
+  };
+  while (done < nodes.size())
+  {
+    vector<pollfd> descriptors = {{listener, POLLIN, 0}};
+    Clock::time_point first = Clock::now() + TIMEOUT; //< The first deadline
+    for (const auto& [descriptor, worker] : workers)
+    {
+      descriptors.push_back({descriptor, POLLIN, 0});
+      first = min(first, worker.deadline);
+    }
+    auto wait = chrono::duration_cast<chrono::milliseconds>(first - Clock::now()).count();
+    if (poll(descriptors.data(), descriptors.size(), max(0, int(wait)) + 1) < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      throw runtime_error(string("poll: ") + strerror(errno));
+    }
+    if (descriptors[0].revents & POLLIN)
+    {
+      int descriptor = accept(listener, nullptr, nullptr);
+      if (descriptor >= 0)
+      {
+        cerr << "worker " << descriptor << " connected" << endl;
+        workers[descriptor].deadline = Clock::now() + TIMEOUT;
+        assign(descriptor, workers[descriptor]);
+      }
+    }
+    for (size_t index = 1; index < descriptors.size(); ++ index)
+    {
+      if (not descriptors[index].revents)
+      {
+        continue;
+      }
+      int descriptor = descriptors[index].fd;
+      Worker& worker = workers[descriptor];
+      vector<string> lines;
+      bool open = receiveLines(descriptor, worker.buffer, lines);
+      worker.deadline = Clock::now() + TIMEOUT; //< Any message, a heartbeat too
+      for (const string& line : lines)
+      {
+        istringstream message(line);
+        string kind;
+        long id = -1, count = -1;
+        message >> kind >> id >> count;
+        if (kind == "DONE" and id == worker.job and count >= 0)
+        {
+          if (nodes[id] < 0) //< Not already given by a worker that was thought dead
+          {
+            nodes[id] = count;
+            ++ done;
+            if (log)
+            {
+              *log << id << ' ' << count << endl;
+            }
+          }
+          worker.job = -1;
+        }
+      }
+      if (not open)
+      {
+        drop(descriptor, "lost");
+        continue;
+      }
+      assign(descriptor, worker);
+    }
+    vector<int> silent;
+    for (const auto& [descriptor, worker] : workers)
+    {
+      if (worker.deadline <= Clock::now())
+      {
+        silent.push_back(descriptor);
+      }
+    }
+    for (const int descriptor : silent)
+    {
+      drop(descriptor, "timed out");
+    }
+    for (auto& [descriptor, worker] : workers) //< The idle workers take the jobs given back
+    {
+      assign(descriptor, worker);
+    }
+  }
+
+  for (const auto& [descriptor, worker] : workers)
+  {
+    sendLine(descriptor, "QUIT");
+    close(descriptor);
+  }
+  close(listener);
+  if (address.rfind("unix:", 0) == 0)
+  {
+    unlink(address.substr(5).c_str());
+  }
+  for (size_t id = 0; id < subtrees.size(); ++ id)
+  {
+    output[subtrees[id].root] += nodes[id];
+  }
+  return output;
+}
+
+
+int workerCommand(const int argc, char** argv)
+{
+  string address;
+  int threads = 0, megabytes = 0;
+  try
+  {
+    for (int index = 0; index < argc; ++ index)
+    {
+      string argument = argv[index];
+      if (argument == "--threads" and index + 1 < argc)
+      {
+        threads = stoi(argv[++ index]);
+      }
+      else if (argument == "--hash" and index + 1 < argc)
+      {
+        megabytes = stoi(argv[++ index]);
+      }
+      else if (address.empty())
+      {
+        address = argument;
+      }
+      else
+      {
+        throw invalid_argument(argument);
+      }
+    }
+  }
+  catch (const logic_error&)
+  {
+    address.clear();
+  }
+  if (address.empty() or threads < 0 or megabytes < 0)
+  {
+    cerr << "usage: chess worker <unix:path | host:port> [--threads N] [--hash MB]" << endl;
+    return 1;
+  }
+
+  unique_ptr<PerftTable> table;
+  try
+  {
+    if (megabytes)
+    {
+      table = make_unique<PerftTable>(megabytes);
+    }
+  }
+  catch (const bad_alloc&)
+  {
+    cerr << "cannot allocate a hash table of " << megabytes << " MB (--hash)" << endl;
+    return 1;
+  }
+
+  int descriptor = -1;
+  for (int attempt = 0; descriptor < 0; ++ attempt) //< The coordinator may still be starting
+  {
+    try
+    {
+      descriptor = openSocket(address, false);
+    }
+    catch (const runtime_error& error)
+    {
+      if (attempt == 20)
+      {
+        cerr << error.what() << endl;
+        return 1;
+      }
+      this_thread::sleep_for(chrono::milliseconds(250));
+    }
+  }
+
+  // The heartbeat: the coordinator drops a worker that stays silent (see TIMEOUT), even during a long job
+  mutex sending; //< The heartbeat and the answers share the socket
+  condition_variable wake;
+  bool stopped = false;
+  thread heartbeat([&]
+  {
+    unique_lock<mutex> lock(sending);
+    while (not wake.wait_for(lock, HEARTBEAT, [&stopped] { return stopped; }))
+    {
+      sendLine(descriptor, "ALIVE");
+    }
+  });
+  auto quit = [&](const int status)
+  {
+    {
+      lock_guard<mutex> guard(sending);
+      stopped = true;
+    }
+    wake.notify_one();
+    heartbeat.join();
+    close(descriptor);
+    return status;
+  };
+
+  Game game;
+  string buffer;
+  vector<string> lines;
+  while (receiveLines(descriptor, buffer, lines))
+  {
+    for (const string& line : lines)
+    {
+      istringstream message(line);
+      string kind, fen;
+      long id = -1;
+      int depth = -1;
+      message >> kind >> id >> depth;
+      getline(message >> ws, fen);
+      if (kind == "QUIT")
+      {
+        return quit(0);
+      }
+      if (kind != "JOB" or depth < 0)
+      {
+        cerr << "unexpected message: " << line << endl;
+        continue;
+      }
+      try
+      {
+        game.setFen(fen);
+      }
+      catch (const runtime_error& error)
+      {
+        cerr << "job " << id << ": " << error.what() << endl;
+        return quit(1); //< The coordinator sees the disconnection and gives the job to another worker
+      }
+      long nodes = depth ? 0 : 1;
+      for (const long count : divide(game, depth, threads, table.get()))
+      {
+        nodes += count;
+      }
+      unique_lock<mutex> lock(sending);
+      bool sent = sendLine(descriptor, "DONE " + to_string(id) + ' ' + to_string(nodes));
+      lock.unlock();
+      if (not sent)
+      {
+        cerr << "coordinator lost" << endl;
+        return quit(1);
+      }
+    }
+    lines.clear();
+  }
+  cerr << "coordinator lost" << endl;
+  return quit(1);
+}
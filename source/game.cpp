@@ -19,6 +19,10 @@
 # include "../header/rook.hpp"
 # include "../header/king.hpp"
 # include "../header/game.hpp"
+# include "../header/movecache.hpp"
+# include "../header/rules.hpp"
+# include "../header/stats.hpp"
+# include "../header/trace.hpp"
 
 // #### Ncurses inclusion: ####
 # include <ncurses.h>
@@ -28,59 +32,78 @@
 # include <vector>
 # include <iostream>
 # include <algorithm>
+# include <cstring>
 # include <fstream>
+# include <memory>
+# include <new>
 # include <filesystem>
-# include <unordered_map>
+# include <sstream>
 using namespace std;
 namespace fs = filesystem;
 
-extern vector<vector<int>> KNIGHT_MOVES;
+
+Facades::Facades() noexcept
+{
+  clear();
+}
 
 
-Game::Game()
+Facades::~Facades()
 {
-  for (int y = 0; y < SIZE; ++ y)
-  {
-    _board.push_back(vector<Piece*>(SIZE, nullptr));
-  }
+  clear();
+}
+
 
-  for (int x = 0; x < SIZE; ++ x) // Pawns
+int Facades::allocate()
+{
+  if (free < 0)
   {
-    _board[1][x] = new Pawn(1, x, 1, this);
-    _board[6][x] = new Pawn(0, x, 6, this);
+    throw runtime_error("more than " + to_string(SLOTS) + " pieces in a game");
   }
+  int output = free;
+  free = slots[output].next;
+  return output;
+}
+
 
-  _board[0][1] = new Knight(1, 1, 0, this);
-  _board[0][6] = new Knight(1, 6, 0, this);
-  _board[7][1] = new Knight(0, 1, 7, this);
-  _board[7][6] = new Knight(0, 6, 7, this);
+void Facades::release(const int slot) noexcept
+{
+  slots[slot].piece->~Piece();
+  slots[slot].piece = nullptr;
+  slots[slot].next = free;
+  free = slot;
+}
 
-  _board[0][0] = new Rook(1, 0, 0, this);
-  _board[0][7] = new Rook(1, 7, 0, this);
-  _board[7][0] = new Rook(0, 0, 7, this);
-  _board[7][7] = new Rook(0, 7, 7, this);
 
-  _board[0][2] = new Bishop(1, 2, 0, this);
-  _board[0][5] = new Bishop(1, 5, 0, this);
-  _board[7][2] = new Bishop(0, 2, 7, this);
-  _board[7][5] = new Bishop(0, 5, 7, this);
+void Facades::clear() noexcept
+{
+  for (int index = 0; index < SLOTS; ++ index)
+  {
+    if (slots[index].piece != nullptr)
+    {
+      slots[index].piece->~Piece();
+      slots[index].piece = nullptr;
+    }
+    slots[index].next = index + 1 < SLOTS ? index + 1 : -1;
+  }
+  fill(begin(squares), end(squares), -1);
+  retired = -1;
+  free = 0;
+}
 
-  _board[0][3] = new Queen(1, 3, 0, this);
-  _board[7][3] = new Queen(0, 3, 7, this);
 
-  _whiteKing = new King(0, 4, 7, this);
-  _blackKing = new King(1, 4, 0, this);
-  _board[7][4] = _whiteKing;
-  _board[0][4] = _blackKing;
+Game::Game():
+_facades(make_unique<Facades>())
+{
+  setFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
 }
 
 
-Game::Game(string path)
+Game::Game(string path):
+_facades(make_unique<Facades>())
 {
-  for (int y = 0; y < SIZE; ++ y)
-  {
-    _board.push_back(vector<Piece*>(SIZE, nullptr));
-  }
+  TRACE_SCOPE("Game::load");
+  clear(); //< Empty board
   ifstream file(path);
   if (!file)
   {
@@ -95,30 +118,49 @@ Game::Game(string path)
   init50moves(file);
   // Get _board
   initBoard(file);
-  // Get _checkList
+  // Check the checks
   initCheckList(file);
   // Sanity check: kings must exist
   sanityCheck();
+  _hash ^= stateKey();
   _name = fs::directory_entry(path).path().filename();
 }
 
 
+Game::Game(const Position& position):
+_facades(make_unique<Facades>())
+{
+  setPosition(position);
+}
+
+
 Game::~Game()
 {
-  for (const vector<Piece*>& row : _board)
+  clear();
+}
+
+
+void Game::clear() noexcept
+{
+  _facades->clear();
+  _history.clear();
+  fill(begin(_board), end(_board), NO_PIECE);
+  for (int player = 0; player < 2; ++ player)
   {
-    for (const Piece* piece : row)
+    for (Bitboard& pieces : _pieces[player])
     {
-      if (piece != nullptr)
-      {
-        delete piece;
-      }
+      pieces = 0;
     }
+    _occupied[player] = 0;
   }
+  _turn = 0;
+  _index = _50moveRules = _castling = 0;
+  _enPassant = -1;
+  _hash = 0;
 }
 
 
-vector<vector<Piece*>> Game::board() const noexcept
+const Board& Game::board() const noexcept
 {
   return this->_board;
 }
@@ -130,25 +172,63 @@ bool Game::turn() const noexcept
 }
 
 
-Piece* Game::at(const int x, const int y) const noexcept
+Piece* Game::at(const int x, const int y) const
 {
-  if (x < 0 or y < 0 or x >= SIZE or y >= SIZE)
+  if ((x | y) & ~(SIZE - 1)) //< Negative or too large (SIZE is a power of two)
   {
     return nullptr;
   }
-  return _board[y][x];
+  return facade(square(x, y));
+}
+
+
+CheckList Game::checkList() const
+{
+  CheckList output;
+  Bitboard threats = checkers();
+  int threat;
+  while (threats)
+  {
+    threat = popLsb(threats);
+    output.push_back(facade(threat));
+  }
+  return output;
 }
 
 
-vector<Piece*> Game::checkList() const noexcept
+Bitboard Game::checkers() const noexcept
 {
-  return this->_checkList;
+  return attackersTo(kingSquare(_turn), not _turn, occupied());
 }
 
 
-Piece* Game::king(const bool player) const noexcept
+Piece* Game::king(const bool player) const
 {
-  return player ? _blackKing : _whiteKing;
+  return facade(kingSquare(player));
+}
+
+
+Bitboard Game::pieces(const bool player, const PieceType type) const noexcept
+{
+  return _pieces[player][type];
+}
+
+
+Bitboard Game::occupied(const bool player) const noexcept
+{
+  return _occupied[player];
+}
+
+
+Bitboard Game::occupied() const noexcept
+{
+  return _occupied[0] | _occupied[1];
+}
+
+
+Bitboard Game::attackersTo(const int square, const bool player, const Bitboard occupancy) const noexcept
+{
+  return ::attackersTo(_pieces, square, player, occupancy);
 }
 
 
@@ -158,444 +238,253 @@ int Game::index() const noexcept
 }
 
 
-bool Game::drawBy50Moves() const noexcept
+int Game::castling() const noexcept
 {
-  return this->_50moveRules > 49;
+  return this->_castling;
 }
 
 
-bool Game::drawByRepetition() const noexcept
+int Game::enPassant() const noexcept
 {
-  auto lastPosition = _repetitions.find(_hash);
-  return (lastPosition != _repetitions.end()) and (lastPosition->second >= 3);
+  return this->_enPassant;
 }
 
-vector<char> Game::hash() noexcept
+
+bool Game::drawBy50Moves() const noexcept
 {
-  _hash.clear();
-  _hash.reserve(SIZE * SIZE + 1);
-  _hash.push_back(_turn);
-  for (int y = 0; y < SIZE; ++ y)
+  return this->_50moveRules > 49;
+}
+
+
+bool Game::drawByRepetition() const noexcept
+{
+  int repetitions = 1, last = max(0, int(_history.size()) - _50moveRules);
+  for (int ply = int(_history.size()) - 2; ply >= last; ply -= 2)
   {
-    for (int x = 0; x < SIZE; ++ x)
+    if (_history[ply].hash == _hash and ++ repetitions >= 3)
     {
-      _hash.push_back(_board[y][x] == nullptr ? 0 : _board[y][x]->repr());
+      return true;
     }
   }
-  return _hash;
+  return false;
+}
+
+uint64_t Game::hash() const noexcept
+{
+  return this->_hash;
 }
 
 
-bool Game::move(Piece* piece, const int x, const int y, const bool force)
+bool Game::move(Piece* piece, const int x, const int y, const int promotion)
 {
+  TRACE_SCOPE("Game::move");
+  COUNT_STAT(MOVES);
   // Check the legality of the move:
-  vector<int> pos = {x, y};
-  vector<vector<int>> available = (piece == nullptr ? vector<vector<int>>(/*empty list*/) : piece->read());
-  bool eat = false;
-  if (not force and find(available.begin(), available.end(), pos) == available.end())
+  if (piece == nullptr)
   {
     return 1;
   }
-  if (_board[y][x] != nullptr)
-  {
-    eat = true;
-    delete _board[y][x];
-  }
-  else if (piece->isPawn() and piece->x() != x)
+  for (const Move move : piece->read())
   {
-    eat = true;
-    delete _board[piece->y()][x];
-    _board[piece->y()][x] = nullptr;
-  }
-  else if (piece->isKing() and abs(x - piece->x()) == 2)
-  {
-    Piece* rook = _board[piece->y()][(x - piece->x() == -2) ? 0 : SIZE - 1];
-    if (rook == nullptr)
+    if (move.to() == square(x, y) and move.promotion() == promotion)
     {
-      throw runtime_error("try to castle but no rook was detected");
+      makeMove(move);
+      return 0;
     }
-    int rookTarget = (x - piece->x() == -2) ? x + 1 : x - 1;
-    _board[piece->y()][rookTarget] = rook;
-    _board[rook->y()][rook->x()] = nullptr;
-    rook->move(rookTarget, piece->y());
-
   }
-  _board[y][x] = piece;
-  _board[piece->y()][piece->x()] = nullptr;
-  piece->move(x, y);
-  if (piece->isPawn() or eat)
+  return 1;
+}
+
+
+struct Game::Mover
+{
+  Game& game;
+  uint64_t& hash;
+  int& castling;
+  int& enPassant;
+  int& fiftyMoves;
+  bool& turn;
+  int& index;
+  size_t ply; //< The index in the history of the move
+
+  int typeAt(const int square) const noexcept
   {
-    // Reset 50 moves rule Counting
-    _50moveRules = 0;
-    // Clear the repetitions hash table (things will never be like before)
-    _repetitions.clear();
+    return game._board[square] == NO_PIECE ? -1 : codeType(game._board[square]);
   }
-  else
+
+  Bitboard pieces(const bool player, const int type) const noexcept
   {
-    // Increment 50 moves rule Counting
-    ++ _50moveRules;
+    return game._pieces[player][type];
   }
-  hash();
-  ++ _repetitions[_hash];
-  return 0;
-}
 
+  void lift(const bool player, const int type, const int square)
+  {
+    game.retire(square, ply);
+    game.lift(player, PieceType(type), square);
+  }
 
-void Game::filterMoves(Piece* piece, vector<vector<int>>& moves)
-{
-  /*
-  If K:
-    -> Accept all the moves that resolve current checks in checkList
-    -> & That does not put the K in danger
-  Else:
-    -> Refuse all moves if checkList.size() > 1
-    -> Accept all the moves that eat the possible current check
-    -> | block the possible current check (if check is Q B R)
-    -> & does not discover a check
-  */
-  if (piece->isKing())
+  void place(const bool player, const int type, const int square) noexcept
   {
-    filterKingMoves(piece, moves);
+    game.place(player, PieceType(type), square);
   }
-  else
+
+  void relocate(const bool player, const int type, const int from, const int to) noexcept
   {
-    filterNotKingMoves(piece, moves);
-    if (piece->isPawn() and piece->y() == (piece->player() ? 4 : 3))
-    {
-      filterEnPassant(piece, moves);
-    }
+    game.relocate(player, PieceType(type), from, to);
   }
-}
+};
 
 
-void Game::filterKingMoves(Piece* piece, vector<vector<int>>& moves)
+void Game::makeMove(const Move move)
 {
-  int x = piece->x(), y = piece->y(), moveX, moveY, n = moves.size();
-  Piece* previous;
-  for (int i = 0; i < n; ++ i)
-  {
-    moveX = moves[i][0], moveY = moves[i][1];
-    previous = _board[moveY][moveX];
-    _board[moveY][moveX] = piece;
-    _board[y][x] = nullptr;
-    piece->simulateMove(moveX, moveY);
-    bool notSafe = knightNear(piece) or rookAndQueenNear(piece) or bishopAndQueenNear(piece) or pawnNear(piece) or kingNear(piece);
-    _board[moveY][moveX] = previous;
-    _board[y][x] = piece;
-    piece->simulateMove(x, y);
-    if (notSafe)
-    {
-      swap(moves[i], moves.back());
-      moves.pop_back();
-      -- n;
-      -- i;
-    }
-  }
+  COUNT_STAT(MAKE_MOVES);
+  Undo undo = {_hash, move, uint8_t(_castling), int8_t(_enPassant), int16_t(_50moveRules), -1};
+  Mover board = {*this, _hash, _castling, _enPassant, _50moveRules, _turn, _index, _history.size()};
+  undo.captured = applyMove(board, move);
+  _history.push_back(undo);
 }
 
 
-void Game::filterNotKingMoves(Piece* piece, vector<vector<int>>& moves)
+void Game::unmakeMove()
 {
-  if (_checkList.size() > 1) // double check cannot be stopped by non-king pieces
+  COUNT_STAT(UNMAKE_MOVES);
+  if (_history.empty())
   {
-    moves.clear();
-    return;
+    throw runtime_error("no move to take back");
   }
-  Piece* myKing = king(piece->player());
-  int x = piece->x(), y = piece->y(), moveX, moveY, n = moves.size();
-  if (_checkList.size()) // single check: has to be stopped
+  Undo undo = _history.back();
+  _history.pop_back();
+  size_t ply = _history.size();
+  int from = undo.move.from(), to = undo.move.to(), fromX = squareX(from), fromY = squareY(from), x = undo.move.x();
+  bool player = not _turn;
+  if (undo.move.promotion())
   {
-    Piece* threat = _checkList[0];
-    bool canBeBlocked = threat->isRook() or threat->isBishop() or threat->isQueen();
-    for (int i = 0; i < n; ++ i)
+    lift(player, PROMOTIONS[undo.move.promotion()], to);
+    if (_facades->squares[to] >= 0)
     {
-      moveX = moves[i][0], moveY = moves[i][1];
-      if (
-        (moveX == threat->x() and moveY == threat->y())
-        or
-        (piece->isPawn() and moveX != x and _board[moveY][moveX] == nullptr
-        and threat->isPawn() and threat->x() == moveX and threat->y() == y)
-      )
-      {
-        continue;
-      }
-
-      if (canBeBlocked and _board[moveY][moveX] == nullptr)
-      {
-        _board[moveY][moveX] = piece;
-        _board[y][x] = nullptr;
-        piece->simulateMove(moveX, moveY);
-        bool blocked = not threat->threat(myKing);
-        _board[moveY][moveX] = nullptr;
-        _board[y][x] = piece;
-        piece->simulateMove(x, y);
-        if (blocked)
-        {
-          continue;
-        }
-      }
-      swap(moves[i], moves.back());
-      moves.pop_back();
-      -- n;
-      -- i;
+      _facades->release(_facades->squares[to]);
+      _facades->squares[to] = -1;
     }
+    place(player, PAWN, to);
+    restore(to, player, ply);
   }
-  // Check if the piece is pinned & remove moves that leave the restricted area of pin (I know what Im talking about)
-  Piece* pinned = isDiscoveryCheck(x, y, piece->player());
-  if (pinned != nullptr)
+  relocate(player, codeType(_board[to]), to, from);
+  if (undo.captured >= 0) //< Its position did not change since it was eaten
   {
-    for (int i = 0; i < n; ++ i)
-    {
-      moveX = moves[i][0], moveY = moves[i][1];
-      if (moveX == pinned->x() and moveY == pinned->y())
-      {
-        continue;
-      }
-      if (_board[moveY][moveX] == nullptr)
-      {
-        _board[moveY][moveX] = piece;
-        _board[y][x] = nullptr;
-        piece->simulateMove(moveX, moveY);
-        bool blocked = not pinned->threat(myKing);
-        _board[moveY][moveX] = nullptr;
-        _board[y][x] = piece;
-        piece->simulateMove(x, y);
-        if (blocked)
-        {
-          continue;
-        }
-      }
-      swap(moves[i], moves.back());
-      moves.pop_back();
-      -- n;
-      -- i;
-    }
+    int eaten = undo.move.flag() == Move::EN_PASSANT ? square(x, fromY) : to;
+    place(not player, PieceType(undo.captured), eaten);
+    restore(eaten, not player, ply);
+  }
+  if (undo.move.flag() == Move::CASTLING)
+  {
+    relocate(player, ROOK, square((fromX + x) >> 1, fromY), square(x < fromX ? 0 : SIZE - 1, fromY));
   }
+  _castling = undo.castling;
+  _enPassant = undo.enPassant;
+  _50moveRules = undo.fiftyMoves;
+  _hash = undo.hash;
+  _turn = not _turn;
+  -- _index;
 }
 
 
-void Game::filterEnPassant(Piece* pawn, vector<vector<int>>& moves)
+int Game::discover(const int square, const int kingSquare, const Bitboard sliders, const bool diagonal) const noexcept
 {
-  // En passant
-  int x = pawn->x(), moveX, moveY, n = moves.size();
-  for (int i = 0; i < n; ++ i)
+  int threat;
+  // Look from the king through square as if it was empty
+  Bitboard occupancy = occupied() & ~bit(square);
+  Bitboard threats = (diagonal ? bishopAttacks(kingSquare, occupancy) : rookAttacks(kingSquare, occupancy))
+                   & line(kingSquare, square) & sliders;
+  while (threats)
   {
-    moveX = moves[i][0];
-    moveY = moves[i][1];
-    if (moveX != x and _board[moveY][moveX] == nullptr)
+    threat = popLsb(threats);
+    if (between(kingSquare, threat) & bit(square))
     {
-      bool notBlocked = isDiscoveryCheck(moveX, moveY, pawn->player());
-      if (notBlocked)
-      {
-        swap(moves[i], moves.back());
-        moves.pop_back();
-        -- n;
-        -- i;
-      }
+      return threat;
     }
   }
+  return -1;
 }
 
-void Game::updateCheckList(Piece* piece, const int x, const int y) noexcept
+
+Piece* Game::isDiscoveryCheck(const int x, const int y, const bool player) const
 {
-  _checkList.clear();
-  // Direct 
-  if (piece->threat(king(not piece->player())))
-  {
-    // mvprintw(2, 0, "DIRECT THREAT %s", string(1, piece->repr()).c_str()); // DEBUG
-    _checkList.push_back(piece);
-  }
-  // Discovery check
-  if (piece->isKing())
-  {
-    return; //< Do not check discovery checks because the king cannot be pinned to itself
-  }
-  else if (piece->isPawn() and (piece->player() ? 4 : 3) == y and x != piece->x() and _board[y][piece->x()] == nullptr) // En passant
-  {
-    Piece* threat = isDiscoveryCheck(piece->x(), y, not piece->player());
-    if (threat != nullptr)
-    {
-      _checkList.push_back(threat);
-      return; // En passant cannot discover 2 different checks
-    }
-  }
-  Piece* threat = isDiscoveryCheck(x, y,  not piece->player());
-  if (threat != nullptr)
-  {
-    // mvprintw(3, 0, "DISCOVERY THREAT %s", string(1, threat->repr()).c_str()); // DEBUG
-    _checkList.push_back(threat);
-  }
+  int threat = discoveryThreat(square(x, y), player);
+  return threat >= 0 ? facade(threat) : nullptr;
 }
 
 
-Piece* Game::discoverRow(const int x, const int y, const bool player, Piece* king) const noexcept
+int Game::discoveryThreat(const int square, const bool player) const noexcept
 {
-  // Space between (x, y) and king as to be empty
-  int lowerBound = x < king->x() ? x + 1 : king->x() + 1,
-      upperBound = y < king->x() ? king->x() : x;
-  for (int index = lowerBound; index < upperBound; ++ index)
+  int king = kingSquare(player), x = squareX(square), y = squareY(square), kingX = squareX(king), kingY = squareY(king);
+  const Bitboard* enemies = _pieces[not player];
+  if (kingX == x or kingY == y) // Same col or row
   {
-    if (_board[y][index] != nullptr)
-    {
-      return nullptr;
-    }
+    return discover(square, king, enemies[ROOK] | enemies[QUEEN], false);
   }
-  // Return if there is directly a ROOK/QUEEN after (x, y)
-  int increment = x < king->x() ? -1 : +1, index = x + increment;
-  while (0 <= index and index < SIZE)
+  else if (x - y == kingX - kingY or x + y == kingX + kingY) // Same diag (A or B)
   {
-    if (_board[y][index] == nullptr)
-    {
-      index += increment;
-      continue;
-    }
-    else
-    {
-      return (
-        _board[y][index]->player() != player and (_board[y][index]->isRook() or _board[y][index]->isQueen())
-      ) ? _board[y][index] : nullptr;
-    }
+    return discover(square, king, enemies[BISHOP] | enemies[QUEEN], true);
   }
-  return nullptr;
+  return -1;
 }
 
 
-Piece* Game::discoverCol(const int x, const int y, const bool player, Piece* king) const noexcept
+void Game::legalMoves(MoveList& moves) const noexcept
 {
-  // Space between (x, y) and king as to be empty
-  int lowerBound = y < king->y() ? y + 1 : king->y() + 1,
-      upperBound = y < king->y() ? king->y() : y;
-  for (int index = lowerBound; index < upperBound; ++ index)
-  {
-    if (_board[index][x] != nullptr)
-    {
-      return nullptr;
-    }
-  }
-  // Return if there is directly a ROOK/QUEEN after (x, y)
-  int increment = y < king->y() ? -1 : +1, index = y + increment;
-  while (0 <= index and index < SIZE)
-  {
-    if (_board[index][x] == nullptr)
-    {
-      index += increment;
-      continue;
-    }
-    else
-    {
-      return (
-        _board[index][x]->player() != player and (_board[index][x]->isRook() or _board[index][x]->isQueen())
-      ) ? _board[index][x] : nullptr;
-    }
-  }
-  return nullptr;
+  COUNT_STAT(LEGAL_MOVES);
+  moves.clear();
+  generateMoves(_pieces, _occupied, _turn, _castling, _enPassant, moves);
 }
 
 
-Piece* Game::discoverDiagA(const int x, const int y, const bool player, Piece* king) const noexcept
+int Game::countLegalMoves() const noexcept
 {
-  // Space between (x, y) and king as to be empty
-  int increment = x < king->x() ? +1 : -1;
-  int currentX = x + increment, currentY = y + increment;
-  while (currentX < king->x())
-  {
-    if (_board[currentY][currentX] != nullptr)
-    {
-      return nullptr;
-    }
-    currentX += increment, currentY += increment;
-  }
-  // Return if there is directly a BISHOP/QUEEN after (x, y)
-  increment = increment == 1 ? -1 : +1;
-  currentX = x + increment, currentY = y + increment;
-  while (0 <= currentX and currentX < SIZE and 0 <= currentY and currentY < SIZE)
-  {
-    if (_board[currentY][currentX] == nullptr)
-    {
-      currentX += increment, currentY += increment;
-      continue;
-    }
-    else
-    {
-      return (
-        _board[currentY][currentX]->player() != player and (_board[currentY][currentX]->isBishop() or _board[currentY][currentX]->isQueen())
-      ) ? _board[currentY][currentX] : nullptr;
-    }
-  }
-  return nullptr;
+  COUNT_STAT(COUNT_LEGAL_MOVES);
+  return countMoves(_pieces, _occupied, _turn, _castling, _enPassant);
 }
 
 
-Piece* Game::discoverDiagB(const int x, const int y, const bool player, Piece* king) const noexcept
+void Game::readMoves(MoveList& moves, const int from) const
 {
-  // Space between (x, y) and king as to be empty
-  int increment = x < king->x() ? +1 : -1;
-  int currentX = x + increment, currentY = y - increment;
-  while (currentX < king->x())
+  if (from >= 0) //< The moves of one piece are generated faster than the cache is read
   {
-    if (_board[currentY][currentX] != nullptr)
-    {
-      return nullptr;
-    }
-    currentX += increment, currentY -= increment;
+    moves.clear();
+    generateMoves(_pieces, _occupied, _turn, _castling, _enPassant, moves, bit(from));
+    return;
   }
-  // Return if there is directly a BISHOP/QUEEN after (x, y)
-  increment = increment == 1 ? -1 : +1;
-  currentX = x + increment, currentY = y - increment;
-  while (0 <= currentX and currentX < SIZE and 0 <= currentY and currentY < SIZE)
+  Position key = position();
+  if (MoveCache::shared().find(key, moves))
   {
-    if (_board[currentY][currentX] == nullptr)
-    {
-      currentX += increment, currentY -= increment;
-      continue;
-    }
-    else
-    {
-      return (
-        _board[currentY][currentX]->player() != player and (_board[currentY][currentX]->isBishop() or _board[currentY][currentX]->isQueen())
-      ) ? _board[currentY][currentX] : nullptr;
-    }
+    return;
   }
-  return nullptr;
+  legalMoves(moves);
+  MoveCache::shared().store(key, moves);
 }
 
 
-Piece* Game::isDiscoveryCheck(const int x, const int y, const bool player) const noexcept
+bool Game::isMate()
 {
-  Piece* king = this->king(player);
-  if (king->x() == x) // Same col
-  {
-    return discoverCol(x, y, player, king);
-  }
-  else if (king->y() == y) // Same row
-  {
-    return discoverRow(x, y, player, king);
-  }
-  else if (x - y == king->x() - king->y()) // Same diag (Diag A)
-  {
-    return discoverDiagA(x, y, player, king);
-  }
-  else if (x + y == king->x() + king->y()) // Same diag (Diag B)
+  TRACE_SCOPE("Game::isMate");
+  if (drawBy50Moves() or drawByRepetition())
   {
-    return discoverDiagB(x, y, player, king);
+    return true;
   }
-  return nullptr;
+  return not countLegalMoves();
 }
 
 
-bool Game::isMate() noexcept
+bool Game::operator==(const Game& other) const
 {
-  if (drawBy50Moves() or drawByRepetition())
+  if (other._turn != this->_turn)
   {
-    return true;
+    return false;
   }
-  Piece* piece;
-  for (int i = 0; i < SIZE; ++ i)
+  for (int player = 0; player < 2; ++ player)
   {
-    for (int j = 0; j < SIZE; ++ j)
+    for (int type = PAWN; type <= KING; ++ type)
     {
-      piece = _board[i][j];
-      if (piece != nullptr and piece->player() == _turn and piece->read().size())
+      if (other._pieces[player][type] != this->_pieces[player][type])
       {
         return false;
       }
@@ -605,189 +494,118 @@ bool Game::isMate() noexcept
 }
 
 
-Piece* Game::promote(Piece* piece, int promotion)
+void Game::relocate(const bool player, const PieceType type, const int from, const int to) noexcept
 {
-  Piece* newPiece;
-  int x = piece->x(), y = piece->y();
-  switch (promotion)
+  lift(player, type, from);
+  place(player, type, to);
+  if (_facades->squares[from] >= 0)
   {
-    case 1:
-      newPiece = new Queen(piece->player(), piece->x(), piece->y(), this);
-      break;
-    case 2:
-      newPiece = new Rook(piece->player(), piece->x(), piece->y(), this);
-      break;
-    case 3:
-      newPiece = new Bishop(piece->player(), piece->x(), piece->y(), this);
-      break;
-    case 4:
-      newPiece = new Knight(piece->player(), piece->x(), piece->y(), this);
-      break;
-    default:
-      throw runtime_error("Unknown promotion");
-      break;
+    _facades->squares[to] = _facades->squares[from];
+    _facades->squares[from] = -1;
+    _facades->at(to)->move(squareX(to), squareY(to));
   }
-  _board[y][x] = newPiece;
-  delete piece;
-
-  return newPiece;
 }
 
 
-bool Game::operator==(const Game& other) const
+uint64_t Game::stateKey() const noexcept
 {
-  return (other._turn == this->_turn and other._board == this->_board);
+  return ::stateKey(_castling, _enPassant, _turn);
 }
 
 
-Game& Game::operator++()
+void Game::place(const bool player, const PieceType type, const int square) noexcept
 {
-  _turn = not _turn;
-  ++ _index;
-  return *this;
+  _pieces[player][type] |= bit(square);
+  _occupied[player] |= bit(square);
+  _board[square] = pieceCode(player, type);
+  _hash ^= ZOBRIST.pieces[player][type][square];
 }
 
 
-bool Game::knightNear(Piece* piece)
+void Game::lift(const bool player, const PieceType type, const int square) noexcept
 {
-  Piece* target;
-  int targetX, targetY;
-  for (const vector<int>& knighMove : KNIGHT_MOVES)
-  {
-    targetX = piece->x() + knighMove[0];
-    targetY = piece->y() + knighMove[1];
-    target = at(targetX, targetY);
-    if (target != nullptr and target->isKnight() and target->player() != piece->player())
-    {
-      return true;
-    }
-  }
-  return false;
+  _pieces[player][type] &= ~bit(square);
+  _occupied[player] &= ~bit(square);
+  _board[square] = NO_PIECE;
+  _hash ^= ZOBRIST.pieces[player][type][square];
 }
 
 
-bool Game::rookAndQueenNear(Piece* piece)
+int Game::kingSquare(const bool player) const noexcept
 {
-  bool output = false;
-  int x = piece->x(), y = piece->y();
-  if (not output and x)
-  {
-    if (_board[y][x - 1] != nullptr)
-    {
-      output = (_board[y][x - 1]->player() xor piece->player()) and (_board[y][x - 1]->isRook() or _board[y][x - 1]->isQueen());
-    }
-    else
-    {
-      output = discoverRow(x - 1, y, piece->player(), king(piece->player())) != nullptr;
-    }
-  }
-  if (not output and y)
-  {
-    if (_board[y - 1][x] != nullptr)
-    {
-      output = (_board[y - 1][x]->player() xor piece->player()) and (_board[y - 1][x]->isRook() or _board[y - 1][x]->isQueen());
-    }
-    else
-    {
-      output = discoverCol(x, y - 1, piece->player(), king(piece->player())) != nullptr;
-    }
-  }
-  if (not output and x < SIZE - 1)
-  {
-    if (_board[y][x + 1] != nullptr)
-    {
-      output = (_board[y][x + 1]->player() xor piece->player()) and (_board[y][x + 1]->isRook() or _board[y][x + 1]->isQueen());
-    }
-    else
-    {
-      output = discoverRow(x + 1, y, piece->player(), king(piece->player())) != nullptr;
-    }
-  }
-  if (not output and y < SIZE - 1)
-  {
-    if (_board[y + 1][x] != nullptr)
-    {
-      output = (_board[y + 1][x]->player() xor piece->player()) and (_board[y + 1][x]->isRook() or _board[y + 1][x]->isQueen());
-    }
-    else
-    {
-      output = discoverCol(x, y + 1, piece->player(), king(piece->player())) != nullptr;
-    }
-  }
-  return output;
+  return lsb(_pieces[player][KING]);
 }
 
 
-bool Game::bishopAndQueenNear(Piece* piece)
+Piece* Game::facade(const int square) const
 {
-  bool output = false;
-  int x = piece->x(), y = piece->y();
-  if (not output and x and y)
-  {
-    if (_board[y - 1][x - 1] != nullptr)
-    {
-      output = (_board[y - 1][x - 1]->player() xor piece->player()) and (_board[y - 1][x - 1]->isRook() or _board[y - 1][x - 1]->isQueen());
-    }
-    else
-    {
-      output = discoverDiagA(x - 1, y - 1, piece->player(), king(piece->player())) != nullptr;
-    }
-  }
-  if (not output and y < SIZE - 1 and x < SIZE - 1)
+  if (_board[square] == NO_PIECE)
   {
-    if (_board[y + 1][x + 1] != nullptr)
-    {
-      output = (_board[y + 1][x + 1]->player() xor piece->player()) and (_board[y + 1][x + 1]->isRook() or _board[y + 1][x + 1]->isQueen());
-    }
-    else
-    {
-      output = discoverDiagA(x + 1, y + 1, piece->player(), king(piece->player())) != nullptr;
-    }
+    return nullptr;
   }
-  if (not output and x and y < SIZE - 1)
+  if (_facades->squares[square] >= 0)
   {
-    if (_board[y + 1][x - 1] != nullptr)
-    {
-      output = (_board[y + 1][x - 1]->player() xor piece->player()) and (_board[y + 1][x - 1]->isRook() or _board[y + 1][x - 1]->isQueen());
-    }
-    else
-    {
-      output = discoverDiagB(x - 1, y + 1, piece->player(), king(piece->player())) != nullptr;
-    }
+    return _facades->at(square);
   }
-  if (not output and x < SIZE - 1 and y)
+  bool player = codePlayer(_board[square]);
+  int x = squareX(square), y = squareY(square), type = codeType(_board[square]);
+  Game* game = const_cast<Game*>(this); //< The pieces can play their moves
+  int index = _facades->allocate();
+  Facades::Slot* slot = &_facades->slots[index];
+  Piece* output;
+  switch (type)
   {
-    if (_board[y - 1][x + 1] != nullptr)
-    {
-      output = (_board[y - 1][x + 1]->player() xor piece->player()) and (_board[y - 1][x + 1]->isRook() or _board[y - 1][x + 1]->isQueen());
-    }
-    else
-    {
-      output = discoverDiagB(x + 1, y - 1, piece->player(), king(piece->player())) != nullptr;
-    }
+    case PAWN:
+      output = new (slot->storage) Pawn(player, x, y, game);
+      break;
+    case KNIGHT:
+      output = new (slot->storage) Knight(player, x, y, game);
+      break;
+    case BISHOP:
+      output = new (slot->storage) Bishop(player, x, y, game);
+      break;
+    case ROOK:
+      output = new (slot->storage) Rook(player, x, y, game);
+      break;
+    case QUEEN:
+      output = new (slot->storage) Queen(player, x, y, game);
+      break;
+    default:
+      output = new (slot->storage) King(player, x, y, game);
+      break;
   }
+  slot->piece = output;
+  _facades->squares[square] = index;
   return output;
 }
 
 
-bool Game::pawnNear(Piece* piece)
+void Game::retire(const int square, const size_t ply)
 {
-  int pawnY = piece->y() + (piece->player() ? +1 : -1);
-  Piece* spot1 = at(piece->x() + 1, pawnY),
-       * spot2 = at(piece->x() - 1, pawnY);
-  return (
-    (spot1 != nullptr and spot1->player() != piece->player() and spot1->isPawn())
-    or
-    (spot2 != nullptr and spot2->player() != piece->player() and spot2->isPawn())
-  );
+  int index = _facades->squares[square];
+  if (index >= 0)
+  {
+    _facades->slots[index].ply = ply;
+    _facades->slots[index].next = _facades->retired;
+    _facades->retired = index;
+    _facades->squares[square] = -1;
+  }
 }
 
 
-bool Game::kingNear(Piece* piece)
+void Game::restore(const int square, const bool player, const size_t ply) noexcept
 {
-  Piece* otherKing = king(not piece->player());
-  int diffX = abs(otherKing->x() - piece->x()), diffY = abs(otherKing->y() - piece->y());
-  return (diffX < 2 and diffY < 2 and (diffX or diffY));
+  if (_facades->retired < 0)
+  {
+    return;
+  }
+  const Facades::Slot& last = _facades->slots[_facades->retired];
+  Piece* piece = last.piece;
+  if (last.ply == ply and piece->player() == player and ::square(piece->x(), piece->y()) == square)
+  {
+    _facades->squares[square] = _facades->retired;
+    _facades->retired = last.next;
+  }
 }
 
 
@@ -829,6 +647,8 @@ void Game::init50moves(ifstream& file)
 
 void Game::initBoard(ifstream& file)
 {
+  bool kingMoved[2] = {false, false};
+  _castling = 0;
   for (int y = 0; y < SIZE; ++ y)
   {
     for (int x = 0; x < SIZE; ++ x)
@@ -840,41 +660,63 @@ void Game::initBoard(ifstream& file)
       char pieceType, pieceOwner, doubleUp, didntMove;
       file.read(&pieceType, sizeof(pieceType));
       file.read(&pieceOwner, sizeof(pieceOwner));
+      bool owner = pieceOwner;
+      PieceType type;
       switch (pieceType)
       {
         case 0:
           continue;
         case 'P':
           file.read(&doubleUp, sizeof(doubleUp));
-          _board[y][x] = new Pawn(pieceOwner, x, y, this, doubleUp);
+          type = PAWN;
+          if (doubleUp >= 0 and doubleUp == _index - 1) //< Just moved two squares forward
+          {
+            _enPassant = square(x, y + (owner ? -1 : 1));
+          }
           break;
         case 'R':
           file.read(&didntMove, sizeof(didntMove));
-          _board[y][x] = new Rook(pieceOwner, x, y, this, didntMove);
+          type = ROOK;
+          if (didntMove and y == (owner ? 0 : SIZE - 1) and (x == 0 or x == SIZE - 1))
+          {
+            _castling |= castlingRight(owner, x);
+          }
           break;
         case 'N':
-          _board[y][x] = new Knight(pieceOwner, x, y, this);
+          type = KNIGHT;
           break;
         case 'B':
-          _board[y][x] = new Bishop(pieceOwner, x, y, this);
+          type = BISHOP;
           break;
         case 'Q':
-          _board[y][x] = new Queen(pieceOwner, x, y, this);
+          type = QUEEN;
           break;
         case 'K':
-          if ((pieceOwner ? _blackKing : _whiteKing) != nullptr)
+          if (_pieces[owner][KING])
           {
             throw runtime_error("corrupted file (ERR_CODE: 5)");
           }
           file.read(&didntMove, sizeof(didntMove));
-          (pieceOwner ? _blackKing : _whiteKing) = new King(pieceOwner, x, y, this, didntMove);
-          _board[y][x] = (pieceOwner ? _blackKing : _whiteKing);
+          type = KING;
+          kingMoved[owner] = not didntMove or x != 4 or y != (owner ? 0 : SIZE - 1);
           break;
         default:
           throw runtime_error("corrupted file (ERR_CODE: 4)");
       }
+      place(owner, type, square(x, y));
+    }
+  }
+  for (int player = 0; player < 2; ++ player)
+  {
+    if (kingMoved[player])
+    {
+      _castling &= ~(castlingRight(player, true) | castlingRight(player, false));
     }
   }
+  if (not enPassantCapturable(_pieces[_turn][PAWN], _turn, _enPassant))
+  {
+    _enPassant = -1;
+  }
 }
 
 
@@ -890,18 +732,17 @@ void Game::initCheckList(ifstream& file)
   {
     file.read(&x, sizeof(x));
     file.read(&y, sizeof(y));
-    if (y >= SIZE or x >= SIZE or y < 0 or x < 0 or _board[y][x] == nullptr)
+    if (y >= SIZE or x >= SIZE or y < 0 or x < 0 or not (occupied() & bit(square(x, y))))
     {
       throw runtime_error("corrupted file (ERR_CODE: 7)");
     }
-    _checkList.push_back(_board[y][x]);
   }
 }
 
 
 void Game::sanityCheck()
 {
-  if (_whiteKing == nullptr or _blackKing == nullptr)
+  if (not _pieces[0][KING] or not _pieces[1][KING])
   {
     throw runtime_error("corrupted file (ERR_CODE: 8)");
   }
@@ -910,6 +751,7 @@ void Game::sanityCheck()
 
 void Game::save()
 {
+  TRACE_SCOPE("Game::save");
   static char signature[] = {'C', 'H', 'E', 'S', 'S', 'J', 'K', 'L', 'V'};
   ofstream file("memory/saved_games/" + _name);
   if (!file)
@@ -954,7 +796,7 @@ void Game::writeBoard(ofstream& file)
   {
     for (int x = 0; x < SIZE; ++ x)
     {
-      piece = _board[y][x];
+      piece = at(x, y);
       if (piece == nullptr)
       {
         pieceType = 0;
@@ -992,11 +834,13 @@ void Game::writeBoard(ofstream& file)
 
 void Game::writeCheckList(ofstream& file)
 {
-  char size = _checkList.size(), x, y;
+  Bitboard checks = checkers();
+  char size = popCount(checks), x, y;
   file.write(&size, sizeof(size));
-  for (int index = 0; index < size; ++ index)
+  while (checks)
   {
-    x = _checkList[index]->x(), y = _checkList[index]->y();
+    int threat = popLsb(checks);
+    x = squareX(threat), y = squareY(threat);
     file.write(&x, sizeof(x));
     file.write(&y, sizeof(y));
   }
@@ -1009,6 +853,203 @@ string Game::name() const noexcept
 }
 
 
+string Game::fen() const
+{
+  string output;
+  for (int y = 0; y < SIZE; ++ y)
+  {
+    int empty = 0;
+    for (int x = 0; x < SIZE; ++ x)
+    {
+      PieceCode code = _board[square(x, y)];
+      if (code == NO_PIECE)
+      {
+        ++ empty;
+        continue;
+      }
+      if (empty)
+      {
+        output += char('0' + empty);
+        empty = 0;
+      }
+      output += "PNBRQKpnbrqk"[codeType(code) + 6 * codePlayer(code)];
+    }
+    if (empty)
+    {
+      output += char('0' + empty);
+    }
+    output += y < SIZE - 1 ? '/' : ' ';
+  }
+  output += _turn ? "b " : "w ";
+  string castling;
+  for (int player = 0; player < 2; ++ player)
+  {
+    for (int kingSide = 1; kingSide >= 0; -- kingSide)
+    {
+      if (_castling & castlingRight(player, kingSide))
+      {
+        castling += player ? "kq"[not kingSide] : "KQ"[not kingSide];
+      }
+    }
+  }
+  output += castling.empty() ? "-" : castling;
+  output += ' ';
+  if (_enPassant >= 0)
+  {
+    output += {char('a' + squareX(_enPassant)), char('8' - squareY(_enPassant))};
+  }
+  else
+  {
+    output += '-';
+  }
+  return output + ' ' + to_string(_50moveRules) + ' ' + to_string(_index / 2 + 1);
+}
+
+
+void Game::setFen(const string& fen)
+{
+  istringstream stream(fen);
+  string placement, side = "w", castling = "-", enPassant = "-";
+  int fiftyMoves = 0, moves = 1;
+  stream >> placement;
+  if (stream >> side and stream >> castling and stream >> enPassant and stream >> fiftyMoves)
+  {
+    stream >> moves;
+  }
+  // Check every field before touching the game
+  Position position = {};
+  position.enPassant = -1;
+  int y = 0, x = 0;
+  for (const char symbol : placement)
+  {
+    if (symbol == '/')
+    {
+      if (x != SIZE or ++ y >= SIZE)
+      {
+        throw runtime_error("invalid FEN (wrong number of squares)");
+      }
+      x = 0;
+    }
+    else if ('1' <= symbol and symbol <= '8')
+    {
+      x += symbol - '0';
+    }
+    else if (string("PNBRQKpnbrqk").find(symbol) != string::npos)
+    {
+      if (x >= SIZE)
+      {
+        throw runtime_error("invalid FEN (wrong number of squares)");
+      }
+      position.players[bool(islower(symbol))] |= bit(square(x, y));
+      position.types[string("PNBRQK").find(toupper(symbol))] |= bit(square(x, y));
+      ++ x;
+    }
+    else
+    {
+      throw runtime_error("invalid FEN (unknown piece)");
+    }
+    if (x > SIZE)
+    {
+      throw runtime_error("invalid FEN (wrong number of squares)");
+    }
+  }
+  if (y != SIZE - 1 or x != SIZE)
+  {
+    throw runtime_error("invalid FEN (wrong number of squares)");
+  }
+  if (side != "w" and side != "b")
+  {
+    throw runtime_error("invalid FEN (unknown side to move)");
+  }
+  position.turn = side == "b";
+  if (enPassant != "-")
+  {
+    if (enPassant.size() != 2 or enPassant[0] < 'a' or enPassant[0] > 'h' or enPassant[1] < '1' or enPassant[1] > '8')
+    {
+      throw runtime_error("invalid FEN (wrong en passant square)");
+    }
+    position.enPassant = square(enPassant[0] - 'a', '8' - enPassant[1]);
+    if (not enPassantValid(position))
+    {
+      throw runtime_error("invalid FEN (wrong en passant square)");
+    }
+    if (not enPassantCapturable(position.players[position.turn] & position.types[PAWN], position.turn, position.enPassant))
+    {
+      position.enPassant = -1;
+    }
+  }
+  if (fiftyMoves < 0 or moves < 1)
+  {
+    throw runtime_error("invalid FEN (wrong move counters)");
+  }
+  if (castling != "-" and (castling.empty() or castling.find_first_not_of("KQkq") != string::npos))
+  {
+    throw runtime_error("invalid FEN (unknown castling right)");
+  }
+
+  // Only keep the rights that match the pieces on the board
+  for (const char right : castling)
+  {
+    bool player = islower(right), kingSide = tolower(right) == 'k';
+    int home = player ? 0 : SIZE - 1;
+    if (right != '-'
+        and (position.players[player] & position.types[KING] & bit(square(4, home)))
+        and (position.players[player] & position.types[ROOK] & bit(square(kingSide ? SIZE - 1 : 0, home))))
+    {
+      position.castling |= castlingRight(player, kingSide);
+    }
+  }
+
+  setPosition(position); //< Checks the pieces (see checkPosition)
+  _index = ((moves - 1) << 1) + _turn; //< Not limited to the 16 bits of Position
+  _50moveRules = fiftyMoves;
+}
+
+
+Position Game::position() const noexcept
+{
+  Position output;
+  output.players[0] = _occupied[0];
+  output.players[1] = _occupied[1];
+  for (int type = PAWN; type <= KING; ++ type)
+  {
+    output.types[type] = _pieces[0][type] | _pieces[1][type];
+  }
+  output.hash = _hash;
+  output.index = _index;
+  output.fiftyMoves = _50moveRules;
+  output.turn = _turn;
+  output.castling = _castling;
+  output.enPassant = _enPassant;
+  return output;
+}
+
+
+void Game::setPosition(const Position& position)
+{
+  checkPosition(position); //< Before touching the game
+
+  clear();
+  for (int player = 0; player < 2; ++ player)
+  {
+    for (int type = PAWN; type <= KING; ++ type)
+    {
+      Bitboard pieces = position.players[player] & position.types[type];
+      while (pieces)
+      {
+        place(player, PieceType(type), popLsb(pieces));
+      }
+    }
+  }
+  _turn = position.turn;
+  _index = position.index;
+  _50moveRules = position.fiftyMoves;
+  _castling = position.castling;
+  _enPassant = position.enPassant;
+  _hash ^= stateKey();
+}
+
+
 void Game::setName(string& newName) noexcept
 {
   if (newName.size()) // Does not allow empty names
@@ -1016,3 +1057,15 @@ void Game::setName(string& newName) noexcept
     _name = newName;
   }
 }
+
+
+size_t Game::memoryUsage() const noexcept
+{
+  size_t output = sizeof(Game) + _history.capacity() * sizeof(Undo);
+  const char* name = _name.data();
+  if (name < (const char*)&_name or name >= (const char*)(&_name + 1)) //< Else it is stored inside the string (small string optimization)
+  {
+    output += _name.capacity() + 1;
+  }
+  return output + sizeof(Facades);
+}
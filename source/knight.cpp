@@ -21,59 +21,17 @@ using namespace std;
 # include "../header/piece.hpp"
 
 
-vector<vector<int>> KNIGHT_MOVES = {{2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}};
-
-
 Knight::Knight():
 Piece()
 {
-  _repr = 'N';
+  _code = pieceCode(_player, KNIGHT);
 }
 
 
 Knight::Knight(const bool player, const int x, const int y, Game* game):
 Piece(player, x, y, game)
 {
-  _repr = 'N';
-}
-
-
-bool Knight::isKnight() const noexcept
-{
-  return true;
-}
-
-
-vector<vector<int>> Knight::read() noexcept
-{
-  /*
-    X X
-   X   X
-     N  
-   X   X
-    X X
-  */
-  if (_game->index() == _savedIndex)
-  {
-    return _savedMoves;
-  }
-  _savedMoves.clear();
-  _savedIndex = _game->index();
-
-  int size = _game->SIZE, offsetX, offsetY;
-  _savedMoves.reserve(KNIGHT_MOVES.size());
-  for (const vector<int>& move : KNIGHT_MOVES)
-  {
-    offsetX = _x + move[0];
-    offsetY = _y + move[1];
-    Piece* target = _game->at(offsetX, offsetY);
-    if (0 <= offsetX and 0 <= offsetY and offsetX < size and offsetY < size and (target == nullptr or target->player() != this->player()))
-    {
-      _savedMoves.push_back({offsetX, offsetY});
-    }
-  }
-  _game->filterMoves(this, _savedMoves);
-  return _savedMoves;
+  _code = pieceCode(_player, KNIGHT);
 }
 
 
@@ -83,8 +41,7 @@ bool Knight::threat(Piece* piece)
   {
     return false;
   }
-  int diffX = abs(_x - piece->x()), diffY = abs(_y - piece->y());
-  return (diffX == 1 and diffY == 2) or (diffX == 2 and diffY == 1);
+  return knightAttacks(square(_x, _y)) & bit(square(piece->x(), piece->y()));
 }
 
 ostream& operator<<(ostream& stream, const Knight& me)
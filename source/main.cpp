@@ -17,13 +17,20 @@
 
 // #### Internal inclusions: ####
 # include "../header/main.hpp"
+# include "../header/bench.hpp"
+# include "../header/check.hpp"
 # include "../header/game.hpp"
 # include "../header/getkey.hpp"
+# include "../header/perft.hpp"
+# include "../header/stats.hpp"
+# include "../header/trace.hpp"
+# include "../header/distributed.hpp"
 # include "../header/tui.hpp"
 
 
 vector<int> getPos(TUI& tui, bool abortFlag)
 {
+  TRACE_SCOPE("getPos");
   int input;
   do {
     input = getkey();
@@ -48,6 +55,7 @@ vector<int> getPos(TUI& tui, bool abortFlag)
 
 int run(Game* game, TUI& tui)
 {
+  TRACE_SCOPE("run");
   bool state = false, isOver = false;
   int x, y;
   Piece* piece;
@@ -65,13 +73,12 @@ int run(Game* game, TUI& tui)
       else
       {
         x = piece->x(), y = piece->y();
-        if (piece->isPawn() and (pos[1] == 7 or not pos[1]) and abs(pos[0] - piece->x()) == 1)
+        if (piece->isPawn() and (pos[1] == 7 or not pos[1])) //< Straight or diagonal, every move to the last row promotes
           {
             int promotion = tui.askPromotion();
             if (promotion)
             {
-              piece = game->promote(piece, promotion);
-              isOver = not game->move(piece, pos[0], pos[1], true);
+              isOver = not game->move(piece, pos[0], pos[1], promotion);
             }
             tui.showMessage(game->turn() ? "Black's turn" : "White's turn");
             tui.show();
@@ -97,8 +104,6 @@ int run(Game* game, TUI& tui)
     }
   }
   tui.move(x, y, piece->x(), piece->y());
-  game->updateCheckList(piece, x, y);
-  ++ *game;
   return 0;
 }
 
@@ -129,7 +134,7 @@ int newGame(TUI& tui, Game* game, bool fromFile)
   {
     tui.showMessage("Draw: repetition");
   }
-  else if (game->checkList().size())
+  else if (not game->checkList().empty())
   {
     tui.showMessage("Checkmate");
   }
@@ -199,7 +204,74 @@ int menu()
 }
 
 
-int main()
+/**
+ * @brief Run the command (or the menu) given by the arguments
+ *
+ * @param arguments The arguments, without the program name and the --stats and --trace flags
+ * @return int The exit code
+ */
+int dispatch(vector<char*>& arguments)
 {
+  string command = arguments.size() ? arguments[0] : "";
+  int argc = arguments.size() - 1;
+  char** argv = arguments.data() + 1;
+  if (command == "perft") //< Headless mode, ncurses is never started
+  {
+    return perftCommand(argc, argv);
+  }
+  if (command == "worker")
+  {
+    return workerCommand(argc, argv);
+  }
+  if (command == "bench")
+  {
+    return benchCommand(argc, argv);
+  }
+  if (command == "check")
+  {
+    return checkCommand(argc, argv);
+  }
   return menu();
+}
+
+
+int main(int argc, char** argv)
+{
+  vector<char*> arguments;
+  bool stats = false;
+  string trace;
+  for (int index = 1; index < argc; ++ index)
+  {
+    if (string(argv[index]) == "--stats") //< Accepted by every command
+    {
+      stats = true;
+    }
+    else if (string(argv[index]) == "--trace" and index + 1 < argc) //< Same
+    {
+      trace = argv[++ index];
+      startTracing();
+    }
+    else
+    {
+      arguments.push_back(argv[index]);
+    }
+  }
+  int code = dispatch(arguments);
+  if (stats)
+  {
+    printStats(cerr);
+  }
+  if (trace.size())
+  {
+    try
+    {
+      writeTrace(trace);
+    }
+    catch (const runtime_error& error)
+    {
+      cerr << error.what() << endl;
+      return 1;
+    }
+  }
+  return code;
 }
\ No newline at end of file
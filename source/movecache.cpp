@@ -0,0 +1,158 @@
+/**
+ * @file movecache.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the MoveCache class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <algorithm>
+# include <cstring>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/movecache.hpp"
+# include "../header/stats.hpp"
+
+
+namespace
+{
+  /**
+   * @brief To know if two positions have the same legal moves (the clocks are not compared)
+   *
+   * @param first The first position
+   * @param second The second position
+   * @return bool
+   */
+  bool sameMoves(const Position& first, const Position& second) noexcept
+  {
+    return first.hash == second.hash and first.turn == second.turn and first.castling == second.castling
+       and first.enPassant == second.enPassant and not memcmp(first.players, second.players, sizeof(first.players))
+       and not memcmp(first.types, second.types, sizeof(first.types));
+  }
+}
+
+
+MoveCache::MoveCache(const size_t entries):
+_size(WAYS)
+{
+  while (_size < entries)
+  {
+    _size <<= 1;
+  }
+  _entries.reset(new Entry[_size]);
+  _hands.reset(new uint8_t[_size / WAYS]());
+}
+
+
+MoveCache& MoveCache::shared()
+{
+  thread_local MoveCache cache(ENTRIES);
+  return cache;
+}
+
+
+size_t MoveCache::bytes() const noexcept
+{
+  return _size * sizeof(Entry) + _size / WAYS;
+}
+
+
+bool MoveCache::find(const Position& position, MoveList& moves, const int from)
+{
+  COUNT_STAT(CACHE_LOOKUPS);
+  Entry* found = entry(position);
+  if (found == nullptr)
+  {
+    return false;
+  }
+  COUNT_STAT(CACHE_HITS);
+  found->referenced = true;
+  moves.clear();
+  for (const Move move : found->moves)
+  {
+    if (from < 0 or move.from() == from)
+    {
+      moves.push_back(move);
+    }
+  }
+  return true;
+}
+
+
+void MoveCache::store(const Position& position, const MoveList& moves)
+{
+  Entry* first = set(position.hash);
+  uint8_t& hand = _hands[(first - _entries.get()) / WAYS];
+  Entry* chosen = nullptr;
+  for (size_t way = 0; way < WAYS and chosen == nullptr; ++ way) //< The same position, or a free entry
+  {
+    if (not first[way].used or sameMoves(first[way].position, position))
+    {
+      chosen = first + way;
+    }
+  }
+  // Clock: skip (and clear) the entries of the set that were found since the last pass
+  while (chosen == nullptr)
+  {
+    Entry& candidate = first[hand];
+    hand = (hand + 1) % WAYS;
+    if (candidate.referenced)
+    {
+      candidate.referenced = false;
+    }
+    else
+    {
+      chosen = &candidate;
+    }
+  }
+  chosen->position = position;
+  chosen->moves = moves;
+  chosen->used = true;
+  chosen->referenced = false;
+}
+
+
+void MoveCache::erase(const Position& position)
+{
+  Entry* found = entry(position);
+  if (found != nullptr)
+  {
+    found->used = found->referenced = false;
+  }
+}
+
+
+void MoveCache::clear()
+{
+  for (size_t index = 0; index < _size; ++ index)
+  {
+    _entries[index].used = _entries[index].referenced = false;
+  }
+  fill(_hands.get(), _hands.get() + _size / WAYS, 0);
+}
+
+
+MoveCache::Entry* MoveCache::set(const uint64_t hash) const noexcept
+{
+  return &_entries[hash & (_size - WAYS)];
+}
+
+
+MoveCache::Entry* MoveCache::entry(const Position& position) noexcept
+{
+  Entry* first = set(position.hash);
+  for (size_t way = 0; way < WAYS; ++ way)
+  {
+    if (first[way].used and sameMoves(first[way].position, position))
+    {
+      return first + way;
+    }
+  }
+  return nullptr;
+}
@@ -24,110 +24,35 @@ using namespace std;
 Pawn::Pawn():
 Piece()
 {
-  _repr = 'P';
+  _code = pieceCode(_player, PAWN);
 }
 
 
-Pawn::Pawn(const bool player, const int x, const int y, Game* game, int doubleUp):
+Pawn::Pawn(const bool player, const int x, const int y, Game* game):
 Piece(player, x, y, game)
 {
-  _doubleUp = doubleUp;
-  _repr = 'P';
-}
-
-
-bool Pawn::isPawn() const noexcept
-{
-  return true;
+  _code = pieceCode(_player, PAWN);
 }
 
 
 bool Pawn::didntMove() const noexcept
 {
-  return _doubleUp == -1;
+  return _y == (_player ? 1 : _game->SIZE - 2);
 }
 
 int Pawn::doubleUpIndex() const noexcept
 {
-  return _doubleUp;
-}
-
-# include <ncurses.h>
-
-void Pawn::move(const int x, const int y) noexcept
-{
-  if (abs(_y - y) == 2)
-  {
-    _doubleUp = _game->index(); //< Register double up index for En passant
-  }
-  else if (didntMove())
+  if (_game->enPassant() == square(_x, _y + (_player ? -1 : 1)))
   {
-    _doubleUp = -2;
-  }
-  simulateMove(x, y);
-}
-
-
-vector<vector<int>> Pawn::read() noexcept
-{
-  /*
-     X 
-    XXX
-     P
-    (take and en passant conditions for diag. + first move)
-  */
-  if (_game->index() == _savedIndex)
-  {
-    return _savedMoves;
-  }
-  _savedMoves.clear();
-  _savedIndex = _game->index();
-
-  int size = _game->SIZE;
-  int offsetY = _y + (_player ? 1 : -1);
-  if (offsetY >= 0 and offsetY < size and _game->at(_x, offsetY) == nullptr)
-  {
-    _savedMoves.push_back({_x, offsetY});
-    _player ? ++ offsetY : -- offsetY;
-    if (didntMove() and offsetY >= 0 and offsetY < size and _game->at(_x, offsetY) == nullptr)
-    {
-      _savedMoves.push_back({_x, offsetY});   
-    }
-  }
-  offsetY = _y + (_player ? 1 : -1);
-  if (_game->at(_x + 1, offsetY) != nullptr and _game->at(_x + 1, offsetY)->player() != _player)
-  {
-    _savedMoves.push_back({_x + 1, offsetY});   
-  }
-  else if (((_player and _y == 4) or (not _player and _y == 3)) and _game->at(_x + 1, _y) != nullptr and _game->at(_x + 1, _y)->isPawn())
-  { // Possible en passant;
-    Pawn* pawn = (Pawn*)_game->at(_x + 1, _y);
-    if (pawn->player() != _player and pawn->doubleUpIndex() == _game->index() - 1)
-    {
-      _savedMoves.push_back({_x + 1, offsetY});
-    }
-  }
-  if (_game->at(_x - 1, offsetY) != nullptr and _game->at(_x - 1, offsetY)->player() != _player)
-  {
-    _savedMoves.push_back({_x - 1, offsetY});   
-  }
-  else if (((_player and _y == 4) or (not _player and _y == 3)) and _game->at(_x - 1, _y) != nullptr and _game->at(_x - 1, _y)->isPawn())
-  { // Possible en passant;
-    Pawn* pawn = (Pawn*)_game->at(_x - 1, _y);
-    if (pawn->player() != _player and pawn->doubleUpIndex() == _game->index() - 1)
-    {
-    _savedMoves.push_back({_x - 1, offsetY});
-    }
+    return _game->index() - 1;
   }
-  _game->filterMoves(this, _savedMoves);
-  return _savedMoves;
+  return didntMove() ? -1 : -2;
 }
 
 
 bool Pawn::threat(Piece* piece)
 {
-  int diffX = abs(_x - piece->x()), diffY = _y - piece->y();
-  return diffX == 1 and (_player ? -1 : +1) == diffY;
+  return pawnAttacks(_player, square(_x, _y)) & bit(square(piece->x(), piece->y()));
 }
 
 ostream& operator<<(ostream& stream, const Pawn& me)
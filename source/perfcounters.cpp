@@ -0,0 +1,143 @@
+/**
+ * @file perfcounters.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the PerfCounters class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <cerrno>
+# include <cstring>
+using namespace std;
+
+// #### Posix inclusions: ####
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+
+// #### Internal inclusions: ####
+# include "../header/perfcounters.hpp"
+
+
+namespace
+{
+  /**
+   * @brief The type and config of each event (see perf_event_open(2))
+   *
+   */
+  const uint64_t CONFIGS[PerfCounters::EVENTS][2] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}
+  };
+}
+
+
+PerfCounters::PerfCounters() noexcept
+{
+  for (int event = 0; event < EVENTS; ++ event)
+  {
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = CONFIGS[event][0];
+    attributes.config = CONFIGS[event][1];
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1; //< Allowed without privileges (perf_event_paranoid <= 2)
+    attributes.exclude_hv = 1;
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    _descriptors[event] = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+    if (_descriptors[event] < 0 and _error.empty())
+    {
+      _error = string(name(Event(event))) + ": " + strerror(errno);
+    }
+  }
+}
+
+
+PerfCounters::~PerfCounters() noexcept
+{
+  for (const int descriptor : _descriptors)
+  {
+    if (descriptor >= 0)
+    {
+      close(descriptor);
+    }
+  }
+}
+
+
+bool PerfCounters::available() const noexcept
+{
+  for (int event = 0; event < EVENTS; ++ event)
+  {
+    if (available(Event(event)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool PerfCounters::available(const Event event) const noexcept
+{
+  return _descriptors[event] >= 0;
+}
+
+
+string PerfCounters::error() const noexcept
+{
+  return _error;
+}
+
+
+uint64_t PerfCounters::read(const Event event) const noexcept
+{
+  uint64_t values[3] = {}; //< Value, time enabled, time running
+  if (not available(event) or ::read(_descriptors[event], values, sizeof(values)) != sizeof(values) or not values[2])
+  {
+    return 0;
+  }
+  return values[1] == values[2] ? values[0] : uint64_t(double(values[0]) * values[1] / values[2]);
+}
+
+
+const char* PerfCounters::name(const Event event) noexcept
+{
+  static const char* names[EVENTS] = {"cycles", "instructions", "L1 misses", "LLC misses", "branch misses"};
+  return names[event];
+}
+
+
+void PerfCounters::start() noexcept
+{
+  for (const int descriptor : _descriptors)
+  {
+    if (descriptor >= 0)
+    {
+      ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+      ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+}
+
+
+void PerfCounters::stop() noexcept
+{
+  for (const int descriptor : _descriptors)
+  {
+    if (descriptor >= 0)
+    {
+      ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+}
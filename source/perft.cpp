@@ -0,0 +1,261 @@
+/**
+ * @file perft.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the perft script
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <atomic>
+# include <chrono>
+# include <iostream>
+# include <memory>
+# include <new>
+# include <stdexcept>
+# include <string>
+# include <vector>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/distributed.hpp"
+# include "../header/perft.hpp"
+# include "../header/threadpool.hpp"
+
+
+long perft(Game& game, const int depth, PerftTable* table) noexcept
+{
+  if (depth <= 0)
+  {
+    return 1;
+  }
+  if (depth == 1) //< Bulk counting: the leaves are not played
+  {
+    return game.countLegalMoves();
+  }
+  uint64_t nodes = 0;
+  if (table != nullptr and table->probe(game.hash(), depth, nodes)) //< Before the moves are generated
+  {
+    return nodes;
+  }
+  MoveList moves;
+  game.legalMoves(moves);
+  for (const Move move : moves)
+  {
+    game.makeMove(move);
+    nodes += perft(game, depth - 1, table);
+    game.unmakeMove();
+  }
+  if (table != nullptr)
+  {
+    table->store(game.hash(), depth, nodes);
+  }
+  return nodes;
+}
+
+
+vector<Subtree> split(Game& game, const int depth, const size_t count)
+{
+  MoveList moves;
+  game.legalMoves(moves);
+  vector<Subtree> output;
+  for (int index = 0; index < moves.size(); ++ index)
+  {
+    output.push_back({index, {moves[index]}});
+  }
+  for (int ply = 1; ply < depth - 1 and output.size() < count; ++ ply)
+  {
+    vector<Subtree> next;
+    for (const Subtree& subtree : output)
+    {
+      for (const Move move : subtree.path)
+      {
+        game.makeMove(move);
+      }
+      game.legalMoves(moves);
+      for (const Move move : moves)
+      {
+        next.push_back(subtree);
+        next.back().path.push_back(move);
+      }
+      for (size_t index = 0; index < subtree.path.size(); ++ index)
+      {
+        game.unmakeMove();
+      }
+    }
+    output.swap(next);
+  }
+  return output;
+}
+
+
+vector<long> divide(Game& game, const int depth, const int threads, PerftTable* table)
+{
+  MoveList moves;
+  game.legalMoves(moves);
+  vector<long> output(moves.size(), depth == 1);
+  if (depth <= 1)
+  {
+    return output;
+  }
+
+  ThreadPool pool(threads);
+  vector<Subtree> tasks = split(game, depth, size_t(pool.size()) << 5); //< Enough tasks to keep every thread busy
+
+  Position root = game.position(); //< Copied to each thread, without a round trip through a FEN
+  vector<unique_ptr<Game>> games;
+  for (int index = 0; index < pool.size(); ++ index)
+  {
+    games.push_back(make_unique<Game>(root));
+  }
+  vector<atomic<long>> counts(output.size());
+  for (const Subtree& task : tasks)
+  {
+    pool.submit([&, task](const int worker)
+    {
+      Game& local = *games[worker];
+      for (const Move move : task.path)
+      {
+        local.makeMove(move);
+      }
+      counts[task.root] += perft(local, depth - task.path.size(), table);
+      for (size_t index = 0; index < task.path.size(); ++ index)
+      {
+        local.unmakeMove();
+      }
+    });
+  }
+  pool.wait();
+  for (size_t index = 0; index < output.size(); ++ index)
+  {
+    output[index] = counts[index];
+  }
+  return output;
+}
+
+
+int perftCommand(const int argc, char** argv)
+{
+  // Options
+  vector<string> arguments;
+  string address, checkpoint;
+  int threads = 0, megabytes = 0, jobs = 1024;
+  try
+  {
+    for (int index = 0; index < argc; ++ index)
+    {
+      string argument = argv[index];
+      if (argument == "--threads" and index + 1 < argc)
+      {
+        threads = stoi(argv[++ index]);
+      }
+      else if (argument == "--hash" and index + 1 < argc)
+      {
+        megabytes = stoi(argv[++ index]);
+      }
+      else if (argument == "--listen" and index + 1 < argc)
+      {
+        address = argv[++ index];
+      }
+      else if (argument == "--checkpoint" and index + 1 < argc)
+      {
+        checkpoint = argv[++ index];
+      }
+      else if (argument == "--jobs" and index + 1 < argc)
+      {
+        jobs = stoi(argv[++ index]);
+      }
+      else
+      {
+        arguments.push_back(argument);
+      }
+    }
+  }
+  catch (const logic_error&)
+  {
+    arguments.clear();
+  }
+  int depth = -1;
+  try
+  {
+    size_t end = 0;
+    if (arguments.size() and threads >= 0 and megabytes >= 0 and jobs > 0)
+    {
+      depth = stoi(arguments[0], &end);
+      depth = end == arguments[0].size() ? depth : -1;
+    }
+  }
+  catch (const logic_error&)
+  {
+    depth = -1;
+  }
+  if (depth < 0)
+  {
+    cerr << "usage: chess perft <depth> [FEN] [--threads N] [--hash MB]\n"
+         << "       chess perft <depth> [FEN] --listen <unix:path | host:port> [--checkpoint FILE] [--jobs N]" << endl;
+    return 1;
+  }
+  Game game;
+  if (arguments.size() > 1)
+  {
+    string fen = arguments[1];
+    for (size_t index = 2; index < arguments.size(); ++ index) //< Accept an unquoted FEN
+    {
+      fen += " " + arguments[index];
+    }
+    try
+    {
+      game.setFen(fen);
+    }
+    catch (const runtime_error& error)
+    {
+      cerr << error.what() << endl;
+      return 1;
+    }
+  }
+
+  unique_ptr<PerftTable> table;
+  try
+  {
+    if (megabytes)
+    {
+      table = make_unique<PerftTable>(megabytes);
+    }
+  }
+  catch (const bad_alloc&)
+  {
+    cerr << "cannot allocate a hash table of " << megabytes << " MB (--hash)" << endl;
+    return 1;
+  }
+  auto start = chrono::steady_clock::now();
+  MoveList moves;
+  game.legalMoves(moves);
+  vector<long> counts;
+  try
+  {
+    counts = address.empty() ? divide(game, depth, threads, table.get()) : coordinate(game, depth, address, checkpoint, jobs);
+  }
+  catch (const runtime_error& error)
+  {
+    cerr << error.what() << endl;
+    return 1;
+  }
+  long nodes = depth ? 0 : 1;
+  for (int index = 0; index < moves.size(); ++ index)
+  {
+    nodes += counts[index];
+    cout << moves[index].str() << ": " << counts[index] << '\n';
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+  cout << "\nPosition: " << game.fen() << '\n'
+       << "Depth: " << depth << '\n'
+       << "Nodes: " << nodes << '\n'
+       << "Time: " << long(seconds * 1000) << " ms\n"
+       << "Nodes/second: " << long(nodes / max(seconds, 1e-9)) << endl;
+  return 0;
+}
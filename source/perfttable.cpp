@@ -0,0 +1,79 @@
+/**
+ * @file perfttable.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the PerftTable class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Internal inclusions: ####
+# include "../header/perfttable.hpp"
+
+
+PerftTable::PerftTable(const size_t megabytes)
+{
+  size_t count = 1;
+  while ((count << 1) * sizeof(Bucket) <= (megabytes << 20))
+  {
+    count <<= 1;
+  }
+  _buckets.reset(new Bucket[count]);
+  _mask = count - 1;
+  clear();
+}
+
+
+size_t PerftTable::bytes() const noexcept
+{
+  return (_mask + 1) * sizeof(Bucket);
+}
+
+
+bool PerftTable::probe(const uint64_t key, const int depth, uint64_t& nodes) const noexcept
+{
+  for (const Entry& entry : bucket(key, depth).entries)
+  {
+    uint64_t data = entry.data.load(memory_order_relaxed);
+    if ((entry.check.load(memory_order_relaxed) ^ data) == key and int(data & 0xff) == depth)
+    {
+      nodes = data >> 8;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+void PerftTable::store(const uint64_t key, const int depth, const uint64_t nodes) noexcept
+{
+  Entry* entries = bucket(key, depth).entries;
+  // Replace the deepest entry only by a deeper (or as deep) subtree
+  Entry& entry = int(entries[0].data.load(memory_order_relaxed) & 0xff) <= depth ? entries[0] : entries[1];
+  uint64_t data = (nodes << 8) | depth;
+  entry.data.store(data, memory_order_relaxed);
+  entry.check.store(key ^ data, memory_order_relaxed);
+}
+
+
+void PerftTable::clear() noexcept
+{
+  for (size_t index = 0; index <= _mask; ++ index)
+  {
+    for (Entry& entry : _buckets[index].entries)
+    {
+      entry.check.store(0, memory_order_relaxed);
+      entry.data.store(0, memory_order_relaxed);
+    }
+  }
+}
+
+
+PerftTable::Bucket& PerftTable::bucket(const uint64_t key, const int depth) const noexcept
+{
+  // The depth is mixed in, so that the subtrees of one position do not fight for a bucket
+  return _buckets[(key ^ (uint64_t(depth) * 0x9e3779b97f4a7c15ULL)) & _mask];
+}
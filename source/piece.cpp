@@ -13,6 +13,7 @@
 // #### Internal inclusions: ####
 # include "../header/piece.hpp"
 # include "../header/game.hpp"
+# include "../header/stats.hpp"
 
 // #### Std inclusions: ####
 # include <stdexcept>
@@ -46,9 +47,22 @@ int Piece::y() const noexcept
 
 char Piece::repr() const noexcept
 {
-  return this->_repr;
+  return _code == NO_PIECE ? '?' : "PNBRQK"[codeType(_code)];
 }
 
+
+PieceType Piece::type() const noexcept
+{
+  return codeType(_code);
+}
+
+
+PieceCode Piece::code() const noexcept
+{
+  return this->_code;
+}
+
+
 Game* Piece::game() const noexcept
 {
   return this->_game;
@@ -57,58 +71,63 @@ Game* Piece::game() const noexcept
 
 bool Piece::isKing() const noexcept
 {
-  return false;
+  return _code != NO_PIECE and codeType(_code) == KING;
 }
 
 
 bool Piece::isQueen() const noexcept
 {
-  return false;
+  return _code != NO_PIECE and codeType(_code) == QUEEN;
 }
 
 
 bool Piece::isRook() const noexcept
 {
-  return false;
+  return _code != NO_PIECE and codeType(_code) == ROOK;
 }
 
 
 bool Piece::isKnight() const noexcept
 {
-  return false;
+  return _code != NO_PIECE and codeType(_code) == KNIGHT;
 }
 
 
 bool Piece::isBishop() const noexcept
 {
-  return false;
+  return _code != NO_PIECE and codeType(_code) == BISHOP;
 }
 
 
 bool Piece::isPawn() const noexcept
 {
-  return false;
+  return _code != NO_PIECE and codeType(_code) == PAWN;
 }
 
 
-void Piece::simulateMove(const int x, const int y) noexcept
+void Piece::move(const int x, const int y) noexcept
 {
   _x = x;
   _y = y;
 }
 
 
-void Piece::move(const int x, const int y) noexcept
-{
-  simulateMove(x, y);
-}
-
-
-vector<vector<int>> Piece::read()
+MoveList Piece::read() const
 {
-  throw runtime_error(
-    "Piece::read should only be called on a non-empty piece (inheritance)"
-  );
+  if (_game == nullptr or _code == NO_PIECE)
+  {
+    throw runtime_error(
+      "Piece::read should only be called on a non-empty piece (inheritance)"
+    );
+  }
+  COUNT_STAT(READS);
+  MoveList output;
+  if (_player != _game->turn())
+  {
+    return output;
+  }
+  _game->readMoves(output, square(_x, _y));
+  return output;
 }
 
 
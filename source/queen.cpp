@@ -24,148 +24,20 @@ using namespace std;
 Queen::Queen():
 Piece()
 {
-  _repr = 'Q';
+  _code = pieceCode(_player, QUEEN);
 }
 
 
 Queen::Queen(const bool player, const int x, const int y, Game* game):
 Piece(player, x, y, game)
 {
-  _repr = 'Q';
-}
-
-
-bool Queen::isQueen() const noexcept
-{
-  return true;
-}
-
-
-vector<vector<int>> Queen::read() noexcept
-{
-  /*
-    X X X
-     XXX
-    XXQXX
-     XXX
-    x x x
-  */
-  if (_game->index() == _savedIndex)
-  {
-    return _savedMoves;
-  }
-  _savedMoves.clear();
-  _savedIndex = _game->index();
-
-  int size = _game->SIZE, i, j, increI, increJ;
-  // Bishop behavior:
-  for (int a = 0; a < 4; ++ a)
-  {
-    increI = a >> 1 ? 1 : -1;
-    increJ = a & 1 ? 1 : -1;
-    i = _x + increI;
-    j = _y + increJ;
-    while (i >= 0 and i < size and j >= 0 and j < size)
-    {
-      if (not checkTarget(i, j))
-      {
-        break;
-      }
-      i += increI;
-      j += increJ;
-    }
-  }
-  // Rook behavior:
-  for (int i = _x + 1; i < size; ++ i)
-  {
-    if (not checkTarget(i, _y))
-    {
-      break;
-    }
-  }
-  for (int i = _x - 1; i >= 0; -- i)
-  {
-    if (not checkTarget(i, _y))
-    {
-      break;
-    }
-  }
-  for (int i = _y + 1; i < size; ++ i)
-  {
-    if (not checkTarget(_x, i))
-    {
-      break;
-    }
-  }
-  for (int i = _y - 1; i >= 0; -- i)
-  {
-    if (not checkTarget(_x, i))
-    {
-      break;
-    }
-  }
-  _game->filterMoves(this, _savedMoves);
-  return _savedMoves;
+  _code = pieceCode(_player, QUEEN);
 }
 
 
 bool Queen::threat(Piece* piece)
 {
-  if (_x == piece->x())
-  {
-    int lowerBound = _y < piece->y() ? _y + 1 : piece->y() + 1,
-        upperBound = _y < piece->y() ? piece->y() : _y;
-    for (int index = lowerBound; index < upperBound; ++ index)
-    {
-      if (_game->at(_x, index) != nullptr)
-      {
-        return false;
-      }
-    }
-    return true;
-  }
-  else if (_y == piece->y())
-  {
-    int lowerBound = _x < piece->x() ? _x + 1 : piece->x() + 1,
-    upperBound = _x < piece->x() ? piece->x() : _x;
-    for (int index = lowerBound; index < upperBound; ++ index)
-    {
-      if (_game->at(index, _y) != nullptr)
-      {
-        return false;
-      }
-    }
-    return true;
-  }
-  else if (_x - _y == piece->x() - piece->y())
-  { // Diag A
-    int increment = _x < piece->x() ? +1 : -1;
-    int currentX = _x + increment, currentY = _y + increment;
-    while (currentX != piece->x())
-    {
-      if (_game->at(currentX, currentY) != nullptr)
-      {
-        return false;
-      }
-      currentX += increment, currentY += increment;
-    }
-    return true;
-  }
-  else if (_x + _y == piece->x() + piece->y())
-  { // Diag B
-    int increment = _x < piece->x() ? +1 : -1;
-    int currentX = _x + increment, currentY = _y - increment;
-    while (currentX != piece->x())
-    {
-      if (_game->at(currentX, currentY) != nullptr)
-      {
-        return false;
-      }
-      currentX += increment, currentY -= increment;
-    }
-    return true;
-  }
-  return false;
+  return queenAttacks(square(_x, _y), _game->occupied()) & bit(square(piece->x(), piece->y()));
 }
 
 
@@ -175,19 +47,3 @@ ostream& operator<<(ostream& stream, const Queen& me)
          << ", " << me._x << ", " << me._y << ")";
   return stream;
 }
-
-
-bool Queen::checkTarget(const int x, const int y) noexcept
-{
-    Piece* target = _game->at(x, y);
-    if (target == nullptr)
-    {
-      _savedMoves.push_back({x, y});
-      return true;
-    }
-    else if (target->player() != _player)
-    {
-      _savedMoves.push_back({x, y});
-    }
-    return false;
-}
\ No newline at end of file
@@ -24,99 +24,20 @@ using namespace std;
 Rook::Rook():
 Piece()
 {
-  _repr = 'R';
+  _code = pieceCode(_player, ROOK);
 }
 
 
-Rook::Rook(const bool player, const int x, const int y, Game* game, bool didntMove):
+Rook::Rook(const bool player, const int x, const int y, Game* game):
 Piece(player, x, y, game)
 {
-  _repr = 'R';
-  _didntMove = didntMove;
-}
-
-
-bool Rook::isRook() const noexcept
-{
-  return true;
-}
-
-
-vector<vector<int>> Rook::read() noexcept
-{
-  /*
-      X
-      X
-    XXRXX
-      X
-      X
-  */
-  if (_game->index() == _savedIndex)
-  {
-    return _savedMoves;
-  }
-  _savedMoves.clear();
-  _savedIndex = _game->index();
-
-  int size = _game->SIZE;
-  for (int i = _x + 1; i < size; ++ i)
-  {
-    if (not checkTarget(i, _y)){
-      break;
-    }
-  }
-  for (int i = _x - 1; i >= 0; -- i)
-  {
-    if (not checkTarget(i, _y)){
-      break;
-    }
-  }
-  for (int i = _y + 1; i < size; ++ i)
-  {
-    if (not checkTarget(_x, i)){
-      break;
-    }
-  }
-  for (int i = _y - 1; i >= 0; -- i)
-  {
-    if (not checkTarget(_x, i)){
-      break;
-    }
-  }
-  _game->filterMoves(this, _savedMoves);
-  return _savedMoves;
+  _code = pieceCode(_player, ROOK);
 }
 
 
 bool Rook::threat(Piece* piece)
 {
-  if (_x == piece->x())
-  {
-    int lowerBound = _y < piece->y() ? _y + 1 : piece->y() + 1,
-        upperBound = _y < piece->y() ? piece->y() : _y;
-    for (int index = lowerBound; index < upperBound; ++ index)
-    {
-      if (_game->at(_x, index) != nullptr)
-      {
-        return false;
-      }
-    }
-    return true;
-  }
-  else if (_y == piece->y())
-  {
-    int lowerBound = _x < piece->x() ? _x + 1 : piece->x() + 1,
-    upperBound = _x < piece->x() ? piece->x() : _x;
-    for (int index = lowerBound; index < upperBound; ++ index)
-    {
-      if (_game->at(index, _y) != nullptr)
-      {
-        return false;
-      }
-    }
-    return true;
-  }
-  return false;
+  return rookAttacks(square(_x, _y), _game->occupied()) & bit(square(piece->x(), piece->y()));
 }
 
 
@@ -128,30 +49,11 @@ ostream& operator<<(ostream& stream, const Rook& me)
 }
 
 
-bool Rook::checkTarget(const int x, const int y) noexcept
-{
-    Piece* target = _game->at(x, y);
-    if (target == nullptr)
-    {
-      _savedMoves.push_back({x, y});
-      return true;
-    }
-    else if (target->player() != _player)
-    {
-      _savedMoves.push_back({x, y});
-    }
-    return false;
-}
-
-
 bool Rook::didntMove() const noexcept
 {
-  return _didntMove;
-}
-
-
-void Rook::move(const int x, const int y) noexcept
-{
-  _didntMove = false;
-  simulateMove(x, y);
+  if (_y != (_player ? 0 : _game->SIZE - 1) or (_x != 0 and _x != _game->SIZE - 1))
+  {
+    return false;
+  }
+  return _game->castling() & castlingRight(_player, _x);
 }
@@ -1,7 +1,7 @@
 /**
  * @file rules.cpp
  * @author JakeTheRealOne (jakelevrai@outlook.be)
- * @brief Source file for the GameRules class
+ * @brief Source file for the rules on bitboards (the move generation of Game, and the rules on a Position)
  * @version 0.1
  * @date 29-07-2024
  * 
@@ -10,5 +10,530 @@
  */
 
 
+// #### Std inclusions: ####
+# include <stdexcept>
+using namespace std;
+
 // #### Internal inclusions: ####
-# include "../header/rules.hpp"
\ No newline at end of file
+# include "../header/rules.hpp"
+# include "../header/stats.hpp"
+# include "../header/zobrist.hpp"
+
+
+namespace
+{
+  /**
+   * @brief Append a move to every square of targets
+   *
+   * @tparam COUNT If the moves are only counted
+   * @param moves The list of moves (nullptr when counting)
+   * @param from The origin square
+   * @param targets The target squares
+   * @param flag The kind of the moves
+   * @return int The number of moves
+   */
+  template <bool COUNT>
+  int addMoves(MoveList* moves, const int from, Bitboard targets, const Move::Flag flag = Move::QUIET) noexcept
+  {
+    if (COUNT)
+    {
+      return popCount(targets);
+    }
+    int output = 0;
+    while (targets)
+    {
+      moves->push_back(Move(from, popLsb(targets), flag));
+      ++ output;
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief To get a set of squares moved by offset (the squares that leave the board are lost)
+   *
+   * @param set The set of squares
+   * @param offset The move of each square (e.g. -8 for one row up)
+   * @return Bitboard
+   */
+  Bitboard shift(const Bitboard set, const int offset) noexcept
+  {
+    return offset > 0 ? set << offset : set >> -offset;
+  }
+
+
+  /**
+   * @brief Append the moves of several pawns that moved by the same offset (one per new piece on the last row)
+   *
+   * @tparam COUNT If the moves are only counted
+   * @param moves The list of moves (nullptr when counting)
+   * @param targets The target squares
+   * @param offset The target square minus the origin square
+   * @param flag The kind of the moves (if they are not promotions)
+   * @return int The number of moves
+   */
+  template <bool COUNT>
+  int addPawnShifts(MoveList* moves, const Bitboard targets, const int offset, const Move::Flag flag = Move::QUIET) noexcept
+  {
+    const Bitboard lastRows = 0xffULL | 0xffULL << 56;
+    if (COUNT)
+    {
+      return popCount(targets & ~lastRows) + (popCount(targets & lastRows) << 2);
+    }
+    int output = 0, to;
+    Bitboard others = targets & ~lastRows, promotions = targets & lastRows;
+    while (others)
+    {
+      to = popLsb(others);
+      moves->push_back(Move(to - offset, to, flag));
+      ++ output;
+    }
+    while (promotions)
+    {
+      to = popLsb(promotions);
+      for (int promotion = Move::PROMOTION_QUEEN; promotion <= Move::PROMOTION_KNIGHT; ++ promotion)
+      {
+        moves->push_back(Move(to - offset, to, Move::Flag(promotion)));
+        ++ output;
+      }
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief Append the moves of a pawn to every square of targets (one per new piece on the last row)
+   *
+   * @tparam COUNT If the moves are only counted
+   * @param moves The list of moves (nullptr when counting)
+   * @param from The origin square
+   * @param targets The target squares
+   * @return int The number of moves
+   */
+  template <bool COUNT>
+  int addPawnMoves(MoveList* moves, const int from, Bitboard targets) noexcept
+  {
+    const Bitboard lastRows = 0xffULL | 0xffULL << 56;
+    int output = addMoves<COUNT>(moves, from, targets & ~lastRows);
+    for (int flag = Move::PROMOTION_QUEEN; flag <= Move::PROMOTION_KNIGHT; ++ flag)
+    {
+      output += addMoves<COUNT>(moves, from, targets & lastRows, Move::Flag(flag));
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief To get the pieces of the player to move that are pinned to their king
+   *
+   * @param pieces The squares of each kind of piece, for each player
+   * @param occupied The squares occupied by each player
+   * @param player The player to move
+   * @param kingSquare The square of the king of the player to move
+   * @return Bitboard
+   */
+  Bitboard pinned(const Bitboard pieces[2][6], const Bitboard occupied[2], const bool player, const int kingSquare) noexcept
+  {
+    const Bitboard* enemies = pieces[not player];
+    Bitboard output = 0, blockers;
+    // The sliders that would see the king if there were only enemies on the board
+    Bitboard snipers = (rookAttacks(kingSquare, occupied[not player]) & (enemies[ROOK] | enemies[QUEEN]))
+                     | (bishopAttacks(kingSquare, occupied[not player]) & (enemies[BISHOP] | enemies[QUEEN]));
+    while (snipers)
+    {
+      blockers = between(kingSquare, popLsb(snipers)) & (occupied[0] | occupied[1]);
+      if (popCount(blockers) == 1 and (blockers & occupied[player]))
+      {
+        output |= blockers;
+      }
+    }
+    return output;
+  }
+
+
+  /**
+   * @brief To know if an en passant capture leaves the king safe
+   *
+   * @param pieces The squares of each kind of piece, for each player
+   * @param occupancy The occupied squares
+   * @param player The player to move
+   * @param move The en passant capture
+   * @param kingSquare The square of the king of the player to move
+   * @return bool
+   */
+  bool enPassantLegal(const Bitboard pieces[2][6], Bitboard occupancy, const bool player, const Move move, const int kingSquare) noexcept
+  {
+    COUNT_STAT(EN_PASSANT_CHECKS);
+    // En passant removes two pieces from the same row, that could discover a check
+    const Bitboard* enemies = pieces[not player];
+    occupancy = (occupancy ^ bit(move.from()) ^ bit(square(move.x(), squareY(move.from())))) | bit(move.to());
+    return not (rookAttacks(kingSquare, occupancy) & (enemies[ROOK] | enemies[QUEEN]))
+       and not (bishopAttacks(kingSquare, occupancy) & (enemies[BISHOP] | enemies[QUEEN]));
+  }
+
+
+  /**
+   * @brief Helper for generateMoves and countMoves, generate the legal moves of the player to move
+   *
+   * @tparam COUNT If the moves are only counted
+   * @param pieces The squares of each kind of piece, for each player
+   * @param occupied The squares occupied by each player
+   * @param player The player to move
+   * @param castling Bits of CastlingRight
+   * @param enPassant The en passant square (-1 if none)
+   * @param moves The list to fill (nullptr when counting)
+   * @param sources Only the moves of the pieces on these squares are generated
+   * @return int The number of legal moves
+   */
+  template <bool COUNT>
+  int generate(const Bitboard pieces[2][6], const Bitboard occupied[2], const bool player, const int castling,
+               const int enPassant, MoveList* moves, const Bitboard sources) noexcept
+  {
+    const Bitboard* mine = pieces[player];
+    const int kingSquare = lsb(mine[KING]);
+    Bitboard occupancy = occupied[0] | occupied[1], free = ~occupied[player], targets;
+    Bitboard checks = attackersTo(pieces, kingSquare, not player, occupancy);
+    int from, to, count = 0;
+
+    // King: the target must be safe once the king left its square
+    targets = (mine[KING] & sources) ? kingAttacks(kingSquare) & free : 0;
+    ADD_STAT(KING_TESTS, popCount(targets));
+    while (targets)
+    {
+      to = popLsb(targets);
+      if (not attackersTo(pieces, to, not player, occupancy ^ bit(kingSquare)))
+      {
+        count += addMoves<COUNT>(moves, kingSquare, bit(to));
+      }
+    }
+
+    // Double check cannot be stopped by non-king pieces
+    if (popCount(checks) < 2 and (sources & occupied[player] & ~mine[KING]))
+    {
+      // Single check: the move has to eat the threat or to block it
+      Bitboard checkMask = checks ? checks | between(kingSquare, lsb(checks)) : ~Bitboard(0);
+      Bitboard pins = pinned(pieces, occupied, player, kingSquare), mask;
+      Bitboard set = occupied[player] & ~mine[KING] & ~mine[PAWN] & sources;
+      while (set)
+      {
+        from = popLsb(set);
+        // Pinned piece: the move has to stay on the line between the king and the threat
+        mask = free & checkMask & ((pins & bit(from)) ? line(kingSquare, from) : ~Bitboard(0));
+        if (mine[KNIGHT] & bit(from))
+        {
+          count += addMoves<COUNT>(moves, from, knightAttacks(from) & mask);
+        }
+        else
+        {
+          targets = 0;
+          if ((mine[ROOK] | mine[QUEEN]) & bit(from))
+          {
+            targets |= rookAttacks(from, occupancy);
+          }
+          if ((mine[BISHOP] | mine[QUEEN]) & bit(from))
+          {
+            targets |= bishopAttacks(from, occupancy);
+          }
+          count += addMoves<COUNT>(moves, from, targets & mask);
+        }
+      }
+
+      // Pawns that are not pinned: all at once, by shifting the whole set
+      const int forward = player ? 8 : -8;
+      const Bitboard fileA = 0x0101010101010101ULL, fileH = fileA << 7, empty = ~occupancy;
+      set = mine[PAWN] & ~pins & sources;
+      targets = shift(set, forward) & empty;
+      count += addPawnShifts<COUNT>(moves, targets & checkMask, forward);
+      targets = shift(targets & (player ? 0xffULL << 16 : 0xffULL << 40), forward) & empty & checkMask; //< From the starting row
+      count += addPawnShifts<COUNT>(moves, targets, 2 * forward, Move::DOUBLE_PUSH);
+      count += addPawnShifts<COUNT>(moves, shift(set & ~fileA, forward - 1) & occupied[not player] & checkMask, forward - 1);
+      count += addPawnShifts<COUNT>(moves, shift(set & ~fileH, forward + 1) & occupied[not player] & checkMask, forward + 1);
+
+      // Pinned pawns: one by one, along their pin line
+      set = mine[PAWN] & pins & sources;
+      while (set)
+      {
+        from = popLsb(set);
+        mask = checkMask & line(kingSquare, from);
+        targets = pawnAttacks(player, from) & occupied[not player];
+        if (not (occupancy & bit(from + forward)))
+        {
+          targets |= bit(from + forward);
+          if (squareY(from) == (player ? 1 : 6) and not (occupancy & bit(from + 2 * forward)))
+          {
+            count += addMoves<COUNT>(moves, from, bit(from + 2 * forward) & mask, Move::DOUBLE_PUSH);
+          }
+        }
+        count += addPawnMoves<COUNT>(moves, from, targets & mask);
+      }
+
+      // En passant (the pins are checked by enPassantLegal)
+      if (enPassant >= 0 and ((bit(enPassant) | bit(enPassant - forward)) & checkMask))
+      {
+        set = pawnAttacks(not player, enPassant) & mine[PAWN] & sources;
+        while (set)
+        {
+          from = popLsb(set);
+          if (enPassantLegal(pieces, occupancy, player, Move(from, enPassant, Move::EN_PASSANT), kingSquare))
+          {
+            count += addMoves<COUNT>(moves, from, bit(enPassant), Move::EN_PASSANT);
+          }
+        }
+      }
+    }
+
+    // Castling: the king cannot be in check, or go through an attacked square
+    for (int side = 0; side < 2 and not checks and (mine[KING] & sources); ++ side)
+    {
+      int direction = side ? 1 : -1, rook = side ? kingSquare + 3 : kingSquare - 4;
+      if ((castling & castlingRight(player, side)) and not (occupancy & between(kingSquare, rook))
+          and not attackersTo(pieces, kingSquare + direction, not player, occupancy)
+          and not attackersTo(pieces, kingSquare + 2 * direction, not player, occupancy))
+      {
+        count += addMoves<COUNT>(moves, kingSquare, bit(kingSquare + 2 * direction), Move::CASTLING);
+      }
+    }
+    return count;
+  }
+
+
+  /**
+   * @brief To get the pieces of a position by player and kind (the layout of generateMoves)
+   *
+   * @param position The position
+   * @param pieces The squares of each kind of piece, for each player (written)
+   */
+  void unpack(const Position& position, Bitboard pieces[2][6]) noexcept
+  {
+    for (int player = 0; player < 2; ++ player)
+    {
+      for (int type = PAWN; type <= KING; ++ type)
+      {
+        pieces[player][type] = position.players[player] & position.types[type];
+      }
+    }
+  }
+
+
+  /**
+   * @brief Add or remove a piece of a position (and its key)
+   *
+   * @param position The position
+   * @param player The owner of the piece
+   * @param type The kind of the piece
+   * @param square The square of the piece
+   */
+  void toggle(Position& position, const bool player, const int type, const int square) noexcept
+  {
+    position.players[player] ^= bit(square);
+    position.types[type] ^= bit(square);
+    position.hash ^= ZOBRIST.pieces[player][type][square];
+  }
+
+
+  /**
+   * @brief To get the kind of the piece on a square of a position
+   *
+   * @param position The position
+   * @param square The square (not empty)
+   * @return int The PieceType
+   */
+  int typeAt(const Position& position, const int square) noexcept
+  {
+    int type = PAWN;
+    while (not (position.types[type] & bit(square)))
+    {
+      ++ type;
+    }
+    return type;
+  }
+
+
+  /**
+   * @brief A position seen as the board of applyMove
+   *
+   */
+  struct Mover : Position
+  {
+    int typeAt(const int square) const noexcept
+    {
+      return (players[0] | players[1]) & bit(square) ? ::typeAt(*this, square) : -1;
+    }
+
+    Bitboard pieces(const bool player, const int type) const noexcept
+    {
+      return players[player] & types[type];
+    }
+
+    void lift(const bool player, const int type, const int square) noexcept
+    {
+      toggle(*this, player, type, square);
+    }
+
+    void place(const bool player, const int type, const int square) noexcept
+    {
+      toggle(*this, player, type, square);
+    }
+
+    void relocate(const bool player, const int type, const int from, const int to) noexcept
+    {
+      toggle(*this, player, type, from);
+      toggle(*this, player, type, to);
+    }
+  };
+}
+
+
+int castlingLost(const int square) noexcept
+{
+  switch (square)
+  {
+    case ::square(4, 7):
+      return WHITE_SHORT | WHITE_LONG;
+    case ::square(7, 7):
+      return WHITE_SHORT;
+    case ::square(0, 7):
+      return WHITE_LONG;
+    case ::square(4, 0):
+      return BLACK_SHORT | BLACK_LONG;
+    case ::square(7, 0):
+      return BLACK_SHORT;
+    case ::square(0, 0):
+      return BLACK_LONG;
+    default:
+      return 0;
+  }
+}
+
+
+Bitboard attackersTo(const Bitboard pieces[2][6], const int square, const bool player, const Bitboard occupancy) noexcept
+{
+  const Bitboard* attackers = pieces[player];
+  return (knightAttacks(square) & attackers[KNIGHT])
+       | (kingAttacks(square) & attackers[KING])
+       | (pawnAttacks(not player, square) & attackers[PAWN])
+       | (rookAttacks(square, occupancy) & (attackers[ROOK] | attackers[QUEEN]))
+       | (bishopAttacks(square, occupancy) & (attackers[BISHOP] | attackers[QUEEN]));
+}
+
+
+void generateMoves(const Bitboard pieces[2][6], const Bitboard occupied[2], const bool player, const int castling,
+                   const int enPassant, MoveList& moves, const Bitboard sources) noexcept
+{
+  generate<false>(pieces, occupied, player, castling, enPassant, &moves, sources);
+}
+
+
+int countMoves(const Bitboard pieces[2][6], const Bitboard occupied[2], const bool player, const int castling,
+               const int enPassant) noexcept
+{
+  return generate<true>(pieces, occupied, player, castling, enPassant, nullptr, ~Bitboard(0));
+}
+
+
+bool enPassantCapturable(const Bitboard pawns, const bool player, const int enPassant) noexcept
+{
+  return enPassant >= 0 and (pawnAttacks(not player, enPassant) & pawns);
+}
+
+
+bool enPassantValid(const Position& position) noexcept
+{
+  const int target = position.enPassant, forward = position.turn ? 8 : -8; //< The way the pawns of the player to move go
+  const Bitboard occupancy = position.players[0] | position.players[1];
+  return target >= 0 and target < 64 and squareY(target) == (position.turn ? 5 : 2)
+     and not (occupancy & (bit(target) | bit(target + forward)))
+     and (position.players[not position.turn] & position.types[PAWN] & bit(target - forward));
+}
+
+
+void checkPosition(const Position& position)
+{
+  const Bitboard occupancy = position.players[0] | position.players[1];
+  Bitboard types = 0;
+  int count = 0;
+  for (const Bitboard set : position.types)
+  {
+    types |= set;
+    count += popCount(set);
+  }
+  if ((position.players[0] & position.players[1]) or types != occupancy or count != popCount(occupancy))
+  {
+    throw runtime_error("invalid position (two pieces on a square, or a piece without kind or owner)");
+  }
+  if (popCount(position.players[0] & position.types[KING]) != 1 or popCount(position.players[1] & position.types[KING]) != 1)
+  {
+    throw runtime_error("invalid position (each player needs one king)");
+  }
+  for (int player = 0; player < 2; ++ player)
+  {
+    if (popCount(position.players[player]) > 16 or popCount(position.players[player] & position.types[PAWN]) > 8)
+    {
+      throw runtime_error("invalid position (more than 16 pieces or 8 pawns for a player)");
+    }
+  }
+  if (position.types[PAWN] & (0xffULL | 0xffULL << 56))
+  {
+    throw runtime_error("invalid position (pawn on the first or last row)");
+  }
+  for (int right = 0; right < 4; ++ right)
+  {
+    bool player = right >> 1, kingSide = not (right & 1);
+    int home = player ? 0 : 7;
+    if ((position.castling & castlingRight(player, kingSide))
+        and not ((position.players[player] & position.types[KING] & bit(square(4, home)))
+                 and (position.players[player] & position.types[ROOK] & bit(square(kingSide ? 7 : 0, home)))))
+    {
+      throw runtime_error("invalid position (castling right without its king and rook)");
+    }
+  }
+  if (position.castling > (WHITE_SHORT | WHITE_LONG | BLACK_SHORT | BLACK_LONG))
+  {
+    throw runtime_error("invalid position (unknown castling right)");
+  }
+  if (position.enPassant != -1 and not enPassantValid(position))
+  {
+    throw runtime_error("invalid position (wrong en passant square)");
+  }
+}
+
+
+void legalMoves(const Position& position, MoveList& moves)
+{
+  checkPosition(position);
+  Bitboard pieces[2][6];
+  unpack(position, pieces);
+  moves.clear();
+  generate<false>(pieces, position.players, position.turn, position.castling, position.enPassant, &moves, ~Bitboard(0));
+}
+
+
+int countLegalMoves(const Position& position)
+{
+  checkPosition(position);
+  Bitboard pieces[2][6];
+  unpack(position, pieces);
+  return generate<true>(pieces, position.players, position.turn, position.castling, position.enPassant, nullptr, ~Bitboard(0));
+}
+
+
+Bitboard checkers(const Position& position)
+{
+  checkPosition(position);
+  Bitboard pieces[2][6];
+  unpack(position, pieces);
+  return attackersTo(pieces, lsb(pieces[position.turn][KING]), not position.turn, position.players[0] | position.players[1]);
+}
+
+
+Position play(const Position& position, const Move move)
+{
+  checkPosition(position);
+  if (not (position.players[position.turn] & bit(move.from())))
+  {
+    throw runtime_error("no piece of the player to move on the origin of the move");
+  }
+  Mover output = {position};
+  applyMove(output, move);
+  return output;
+}
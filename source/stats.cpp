@@ -0,0 +1,74 @@
+/**
+ * @file stats.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the counters of the move generation (see the --stats flag)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <algorithm>
+# include <iomanip>
+# include <mutex>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/stats.hpp"
+
+
+# ifdef CHESS_STATS
+namespace
+{
+  mutex totalsLock;
+  uint64_t totals[STATS] = {}; //< The sums of the flushed counters
+}
+
+
+thread_local uint64_t threadStats[STATS] = {};
+# endif
+
+
+void flushStats() noexcept
+{
+# ifdef CHESS_STATS
+  lock_guard<mutex> guard(totalsLock);
+  for (int stat = 0; stat < STATS; ++ stat)
+  {
+    totals[stat] += threadStats[stat];
+    threadStats[stat] = 0;
+  }
+# endif
+}
+
+
+void printStats(ostream& stream)
+{
+# ifndef CHESS_STATS
+  stream << "statistics are compiled out, rebuild with: make clean && make STATS=1" << endl;
+# else
+  static const char* names[STATS] = {
+    "Piece::read", "MoveCache lookups", "  found",
+    "king squares tested", "en passant checks", "Game::move", "Game::makeMove",
+    "Game::unmakeMove", "Game::legalMoves", "Game::countLegalMoves"
+  };
+  flushStats();
+  lock_guard<mutex> guard(totalsLock);
+  // The rates are given per played move: Game::move in a game, Game::makeMove in a perft
+  uint64_t moves = max(totals[MOVES], totals[MAKE_MOVES]);
+  stream << "\nStatistics:\n" << left << setw(26) << "counter" << right << setw(16) << "total" << setw(12) << "per move" << '\n';
+  for (int stat = 0; stat < STATS; ++ stat)
+  {
+    stream << left << setw(26) << names[stat] << right << setw(16) << totals[stat]
+           << setw(12) << fixed << setprecision(2) << (moves ? double(totals[stat]) / moves : 0.) << '\n';
+  }
+  if (totals[CACHE_LOOKUPS])
+  {
+    stream << "MoveCache hit rate: " << setprecision(1) << 100. * totals[CACHE_HITS] / totals[CACHE_LOOKUPS] << "%\n";
+  }
+  stream << flush;
+# endif
+}
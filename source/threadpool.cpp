@@ -0,0 +1,131 @@
+/**
+ * @file threadpool.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the ThreadPool class
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Internal inclusions: ####
+# include "../header/stats.hpp"
+# include "../header/threadpool.hpp"
+
+
+ThreadPool::ThreadPool(const int size)
+{
+  int count = size > 0 ? size : max(1u, thread::hardware_concurrency());
+  for (int index = 0; index < count; ++ index)
+  {
+    _queues.push_back(make_unique<Queue>());
+  }
+  for (int index = 0; index < count; ++ index)
+  {
+    _workers.emplace_back(&ThreadPool::work, this, index);
+  }
+}
+
+
+ThreadPool::~ThreadPool()
+{
+  wait();
+  {
+    lock_guard<mutex> guard(_lock);
+    _stop = true;
+  }
+  _wake.notify_all();
+  for (thread& worker : _workers)
+  {
+    worker.join();
+  }
+}
+
+
+int ThreadPool::size() const noexcept
+{
+  return _workers.size();
+}
+
+
+void ThreadPool::submit(Task task)
+{
+  {
+    lock_guard<mutex> guard(_lock); //< Counted first, so that _pending never goes below 0
+    ++ _queued;
+    ++ _pending;
+  }
+  Queue& queue = *_queues[_next ++ % _queues.size()];
+  {
+    lock_guard<mutex> guard(queue.lock);
+    queue.tasks.push_back(move(task));
+  }
+  _wake.notify_one();
+}
+
+
+void ThreadPool::wait()
+{
+  unique_lock<mutex> guard(_lock);
+  _done.wait(guard, [this] { return not _pending; });
+}
+
+
+void ThreadPool::work(const int index)
+{
+  Task task;
+  while (true)
+  {
+    {
+      unique_lock<mutex> guard(_lock);
+      _wake.wait(guard, [this] { return _queued or _stop; });
+      if (not _queued)
+      {
+        flushStats(); //< Stopped
+        return;
+      }
+    }
+    if (not take(index, task))
+    {
+      continue; //< Another thread was faster
+    }
+    task(index);
+    task = nullptr;
+    lock_guard<mutex> guard(_lock);
+    if (not -- _pending)
+    {
+      _done.notify_all();
+    }
+  }
+}
+
+
+bool ThreadPool::take(const int index, Task& task)
+{
+  int count = _queues.size();
+  for (int offset = 0; offset < count; ++ offset)
+  {
+    Queue& queue = *_queues[(index + offset) % count];
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.tasks.empty())
+    {
+      continue;
+    }
+    if (not offset) // Own queue: the newest task
+    {
+      task = move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+    else // Steal: the oldest task
+    {
+      task = move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    lock_guard<mutex> counter(_lock);
+    -- _queued;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file trace.cpp
+ * @author JakeTheRealOne (jakelevrai@outlook.be)
+ * @brief Source file for the scoped tracing (see the --trace flag)
+ * @version 0.1
+ * @date 18-10-2026
+ *
+ * @copyright Copyright (c) 2024
+ *
+ */
+
+
+// #### Std inclusions: ####
+# include <atomic>
+# include <chrono>
+# include <fstream>
+# include <iomanip>
+# include <memory>
+# include <mutex>
+# include <stdexcept>
+# include <vector>
+using namespace std;
+
+// #### Internal inclusions: ####
+# include "../header/trace.hpp"
+
+
+namespace
+{
+  const int CAPACITY = 1 << 16; //< The events kept by each thread
+
+  /**
+   * @brief A recorded scope
+   *
+   */
+  struct Event
+  {
+    const char* name;
+    int64_t start; //< In nanoseconds since the start of the tracing
+    int64_t duration;
+  };
+
+  /**
+   * @brief The events of a thread (only written by its thread)
+   *
+   */
+  struct Buffer
+  {
+    int thread; //< The index of the thread in the trace
+    uint64_t count = 0; //< The events recorded (the last CAPACITY are kept)
+    Event events[CAPACITY];
+  };
+
+  atomic<bool> tracing(false);
+  chrono::steady_clock::time_point origin;
+  mutex buffersLock;
+  vector<unique_ptr<Buffer>> buffers; //< Kept after the end of their thread, until the trace is written
+  thread_local Buffer* threadBuffer = nullptr;
+
+
+  /**
+   * @brief To get the time since the start of the tracing
+   *
+   * @return int64_t In nanoseconds
+   */
+  int64_t now() noexcept
+  {
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origin).count();
+  }
+
+
+  /**
+   * @brief To get the buffer of the current thread (created the first time)
+   *
+   * @return Buffer*
+   */
+  Buffer* buffer()
+  {
+    if (not threadBuffer)
+    {
+      lock_guard<mutex> guard(buffersLock);
+      buffers.push_back(make_unique<Buffer>());
+      buffers.back()->thread = buffers.size();
+      threadBuffer = buffers.back().get();
+    }
+    return threadBuffer;
+  }
+}
+
+
+TraceScope::TraceScope(const char* name) noexcept:
+_name(name)
+{
+  if (tracing.load(memory_order_relaxed))
+  {
+    _start = now();
+  }
+}
+
+
+TraceScope::~TraceScope() noexcept
+{
+  if (_start < 0)
+  {
+    return;
+  }
+  try
+  {
+    Buffer* events = buffer();
+    events->events[events->count ++ % CAPACITY] = {_name, _start, now() - _start};
+  }
+  catch (const bad_alloc&)
+  {
+    // The scope is lost
+  }
+}
+
+
+void startTracing() noexcept
+{
+  origin = chrono::steady_clock::now();
+  tracing = true;
+}
+
+
+void writeTrace(const string& path)
+{
+  ofstream file(path);
+  if (not file)
+  {
+    throw runtime_error("cannot write the trace " + path);
+  }
+  lock_guard<mutex> guard(buffersLock);
+  file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n" << fixed << setprecision(3);
+  bool first = true;
+  for (const unique_ptr<Buffer>& events : buffers)
+  {
+    uint64_t begin = events->count > CAPACITY ? events->count - CAPACITY : 0;
+    for (uint64_t index = begin; index < events->count; ++ index)
+    {
+      const Event& event = events->events[index % CAPACITY];
+      file << (first ? "" : ",\n") << "{\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << events->thread
+           << ", \"ts\": " << event.start / 1000. << ", \"dur\": " << event.duration / 1000. << "}";
+      first = false;
+    }
+  }
+  file << "\n]}" << endl;
+}
@@ -27,6 +27,7 @@ namespace fs = filesystem;
 # include "../header/game.hpp"
 # include "../header/piece.hpp"
 # include "../header/getkey.hpp"
+# include "../header/trace.hpp"
 # include "../header/tui.hpp"
 
 
@@ -175,6 +176,7 @@ void TUI::computeScreenSize() noexcept
 
 void TUI::show() const noexcept
 {
+  TRACE_SCOPE("TUI::show");
   // Board
   for (int i = 0; i < _game->SIZE; ++ i)
   {
@@ -193,13 +195,14 @@ void TUI::move(const int oldX, const int oldY, const int newX, const int newY) n
   clearMoves();
   update(oldX, oldY);
   update(newX, newY, true);
+  PieceType type = codeType(_game->board()[square(newX, newY)]);
   // En passant
-  if (_game->at(newX, newY)->isPawn() and newX != oldX)
+  if (type == PAWN and newX != oldX)
   {
     update(newX, oldY);
   }
   // Castling
-  else if (_game->at(newX, newY)->isKing() and abs(newX - oldX) == 2)
+  else if (type == KING and abs(newX - oldX) == 2)
   {
     update(newX - oldX == -2 ? 0 : _game->SIZE - 1, newY);
   }
@@ -208,20 +211,21 @@ void TUI::move(const int oldX, const int oldY, const int newX, const int newY) n
 
 bool TUI::showMoves(const int x, const int y) noexcept
 {
+  TRACE_SCOPE("TUI::showMoves");
   clearMoves();
   Piece* piece = _game->at(x, y);
   if (piece == nullptr)
   {
     return 0;
   }
-  vector<vector<int>> moves = piece->read();
-  for (const vector<int>& move : moves)
+  const MoveList moves = piece->read();
+  for (const Move& move : moves)
   {
-    _moves[move[0]].insert(move[1]);
+    _moves[move.x()].insert(move.y());
   }
-  for (const vector<int>& move : moves)
+  for (const Move& move : moves)
   {
-    update(move[0], move[1]);
+    update(move.x(), move.y());
   }
   return (bool)moves.size();
 }
@@ -482,12 +486,13 @@ void TUI::update(const int x, const int y, const bool isCursor) const noexcept
 
   short colorPair = 1 + ((x + y) % 2);
   string content;
+  PieceCode code = _game->board()[square(x, y)]; //< Read from the board, without creating a Piece object
 
   if (_moves[x].find(y) != _moves[x].end())
   {
     content = isCursor ? "+" : ".";
   }
-  else if (_game->at(x, y) == nullptr)
+  else if (code == NO_PIECE)
   {
     colorPair = isCursor ? colorPair : 7 + ((x + y) % 2);
     content = isCursor ? "+" : " ";
@@ -495,8 +500,8 @@ void TUI::update(const int x, const int y, const bool isCursor) const noexcept
   else
   {
     attron(A_BOLD);
-    colorPair = isCursor ? colorPair : 3 + ((x + y) % 2) + (_game->at(x, y)->player() << 1);
-    content = string(1, _game->at(x, y)->repr());
+    colorPair = isCursor ? colorPair : 3 + ((x + y) % 2) + (codePlayer(code) << 1);
+    content = string(1, "PNBRQK"[codeType(code)]);
   }
   attron(COLOR_PAIR(colorPair));
   mvprintw(_yOffset + y, _xOffset + (x << 1), " %s", content.c_str());